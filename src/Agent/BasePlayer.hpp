@@ -32,11 +32,18 @@ public:  ///< Devemos modificar isso e tornar protegidos.
     /**
      * @brief Lista estática compartilhada contendo ponteiros para os comunicadores de todos os jogadores.
      * @details Usada para passar a referência dos "outros jogadores" durante a inicialização
-     * e sincronização (Keep-Alive). Como fazemos o .reserve no construtor, não é necessário
-     * que nos preocupemos com performance.
+     * e sincronização (Keep-Alive). Reservada para o processo inteiro por `reserve_team`.
      */
     inline static std::vector<ServerComm*> _all_players_scom;
 
+    /**
+     * @brief Reserva a lista de comunicadores para todos os agentes do processo.
+     * @details Deve ser chamada antes de criar os jogadores, com a quantidade real de agentes
+     * (ex: 11, ou 22 em self-play), evitando realocações durante os handshakes.
+     * @param agents Quantidade de agentes que serão criados neste processo.
+     */
+    static void reserve_team(size_t agents) { BasePlayer::_all_players_scom.reserve(agents); }
+
 public:
     /**
      * @brief Construtor: Inicializa o jogador e estabelece conexão com o servidor.
@@ -44,29 +51,40 @@ public:
      * representará a lista de posições de cada jogador, define o número do uniforme,
      * executa o protocolo de handshake e registra o comunicador deste jogador na lista global.
      * @param unum Número do uniforme desejado para o agente (1 a 11).
+     * @param handshake Se False, apenas conecta e associa o ambiente; o handshake fica a cargo
+     * de um TeamBootstrapper, que o realiza para o time inteiro em paralelo.
      */
     BasePlayer(
-        uint8_t unum
+        uint8_t unum,
+        bool handshake = True
     ) :
         _env(Logger::get())
     {
-        // Então é a primeira vez que estamos executando
-        if(BasePlayer::_all_players_scom.capacity() < 11){
-            // Otimização: Evita múltiplas realocações do vetor de ponteiros
-            BasePlayer::_all_players_scom.reserve(11);
+        if(handshake){
+            // Inicializa a conexão passando a lista atual de parceiros para sincronia
+            this->_scom.initialize_agent(
+                unum,
+                BasePlayer::_all_players_scom,
+                &this->_env
+            );
+        }
+        else{
+            this->_scom.attach(unum, &this->_env);
         }
-
-        // Inicializa a conexão passando a lista atual de parceiros para sincronia
-        this->_scom.initialize_agent(
-            unum,
-            BasePlayer::_all_players_scom,
-            &this->_env
-        );
 
         // Registra o comunicador deste jogador na lista estática para os próximos agentes
         BasePlayer::_all_players_scom.emplace_back(&this->_scom);
     }
 
+    /**
+     * @brief Processa a percepção recém-interpretada, antes da lógica de decisão.
+     * @details Chamada a cada percepção, no início do "pensar" do agente: atualiza a localização
+     * quando a percepção trouxe visão (Environment::localize).
+     */
+    void perceive() {
+        this->_env.localize();
+    }
+
     /**
      * @brief Comando de beam oficial do agente
      * @param posx Posição X de beam
@@ -75,16 +93,23 @@ public:
      * @param init_beam Booleano para indicar se trata-se do primeiro beam, o de alocação.
      */
     void commit_beam(float posx, float posy, float rotation, bool init_beam = False) {
-        this->_scom.commit(
-            std::format(
-                "(beam {} {} {})",
-                (init_beam) ? TacticalFormation::Default[this->_env.unum - 1][0] :
-                              posx,
-                (init_beam) ? TacticalFormation::Default[this->_env.unum - 1][1] :
-                              posy,
-                (init_beam) ? 0 :
-                              rotation
-            )
+        this->_scom.commands().beam(
+            (init_beam) ? TacticalFormation::Default[this->_env.unum - 1][0] :
+                          posx,
+            (init_beam) ? TacticalFormation::Default[this->_env.unum - 1][1] :
+                          posy,
+            (init_beam) ? 0 :
+                          rotation
         );
     }
+
+    /**
+     * @brief Informa aos companheiros o que sabemos e pretendemos (ver TeamMessage.hpp).
+     * @details O número do uniforme é preenchido a partir do ambiente; a mensagem vai no próximo envio.
+     * @param message Bola, posição e intenção; `unum` é ignorado.
+     */
+    void commit_say(TeamMessage message) {
+        message.unum = this->_env.unum;
+        this->_scom.commands().say(encode_team_message(message).view());
+    }
 };
@@ -0,0 +1,304 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+#include "../Communication/Poller.hpp"
+#include "../Communication/CommStats.hpp"
+#include "BasePlayer.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <vector>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+// --- Bibliotecas de Sistema (POSIX) ---
+#include <pthread.h>
+#include <sched.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @class EpochBarrier
+ * @brief Barreira sem locks que alinha as threads dos agentes ao ciclo do servidor.
+ * @details
+ * Cada thread chama `arrive_and_wait` após enviar seu ciclo. A última a chegar zera o contador
+ * e avança a época, liberando as demais, que esperavam girando sobre a época (spin + yield).
+ * Assim, nenhum agente começa a ler o ciclo N+1 enquanto algum parceiro ainda pensa no ciclo N.
+ *
+ * Um agente que perde a conexão sai da barreira com `leave`, e a espera tem tempo limite:
+ * um parceiro travado não congela o time inteiro.
+ */
+class EpochBarrier {
+private:
+    /**
+     * Época (32 bits altos) e chegadas nesta época (32 bits baixos) em uma única palavra:
+     * toda alteração do contador é condicionada à época em que foi decidida (CAS), de modo que
+     * uma thread nunca desfaz uma chegada de uma época que já foi liberada.
+     */
+    alignas(64) std::atomic<uint64_t> __state{0};
+    alignas(64) std::atomic<uint32_t> __participants{0};
+
+    static constexpr uint64_t COUNT_MASK = 0xFFFFFFFFull;
+
+    static uint64_t __epoch_of(uint64_t state) { return state >> 32; }
+    static uint32_t __count_of(uint64_t state) { return uint32_t(state & COUNT_MASK); }
+
+    /**
+     * @brief Libera a época atual se todos os participantes ativos já chegaram.
+     */
+    void __try_release() {
+        uint64_t state = this->__state.load(std::memory_order_acquire);
+        while(__count_of(state) != 0 && __count_of(state) >= this->__participants.load(std::memory_order_acquire)){
+            // Somente uma thread vence a troca: avança a época e zera o contador de uma vez
+            uint64_t released = (__epoch_of(state) + 1) << 32;
+            if(this->__state.compare_exchange_weak(state, released, std::memory_order_acq_rel, std::memory_order_acquire)){ return; }
+        }
+    }
+
+    /**
+     * @brief Pausa curta dentro do laço de espera.
+     */
+    static void __relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+public:
+    /**
+     * @param participants Quantidade de threads que participam da barreira.
+     */
+    explicit EpochBarrier(uint32_t participants = 0) : __participants(participants) {}
+
+    /**
+     * @brief Reinicia a barreira para uma nova execução (nenhuma thread pode estar esperando).
+     */
+    void reset(uint32_t participants) {
+        this->__state.store(0);
+        this->__participants.store(participants);
+    }
+
+    /**
+     * @brief Época atual (quantidade de ciclos liberados, módulo 2^32).
+     */
+    uint64_t epoch() const { return __epoch_of(this->__state.load(std::memory_order_acquire)); }
+
+    /**
+     * @brief Chega à barreira e espera os demais participantes.
+     * @param[in,out] arrived_at Época em que esta thread chegou pela última vez (inicie com UINT64_MAX).
+     * Evita contar a mesma thread duas vezes se ela voltar após um tempo limite esgotado.
+     * @param timeout Tempo máximo de espera.
+     * @return True se a época foi liberada, False em tempo limite ou encerramento.
+     */
+    bool arrive_and_wait(uint64_t& arrived_at, std::chrono::microseconds timeout) {
+        uint64_t state = this->__state.load(std::memory_order_acquire);
+        uint64_t epoch = __epoch_of(state);
+
+        if(arrived_at != epoch){
+            // A chegada só é contada na época em que foi decidida
+            while(!this->__state.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire)){
+                epoch = __epoch_of(state);
+            }
+            arrived_at = epoch;
+            this->__try_release();
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for(uint32_t spins = 0; this->epoch() == epoch; spins++){
+            if(!::is_running){ return False; }
+            if(spins < 256){ __relax(); continue; }
+            if(std::chrono::steady_clock::now() > deadline){ return False; }
+            std::this_thread::yield();
+        }
+        return True;
+    }
+
+    /**
+     * @brief Remove definitivamente um participante (ex: conexão encerrada pelo servidor).
+     * @param arrived_at Época da última chegada desta thread, para desfazer a contagem pendente.
+     */
+    void leave(uint64_t arrived_at) {
+        // Desfaz a chegada somente se a sua época ainda não foi liberada (senão o contador já foi zerado)
+        uint64_t state = this->__state.load(std::memory_order_acquire);
+        while(__epoch_of(state) == arrived_at && __count_of(state) > 0){
+            if(this->__state.compare_exchange_weak(state, state - 1, std::memory_order_acq_rel, std::memory_order_acquire)){ break; }
+        }
+        this->__participants.fetch_sub(1, std::memory_order_acq_rel);
+        this->__try_release();
+    }
+};
+
+/**
+ * @class TeamScheduler
+ * @brief Runtime com uma thread por agente, fixadas em núcleos e alinhadas ao ciclo do servidor.
+ * @details
+ * Cada thread é dona do laço recebe → pensa → envia de um BasePlayer: dorme no epoll do seu
+ * próprio socket, interpreta a percepção, executa a lógica do agente e envia o ciclo.
+ * Em seguida, espera os parceiros na EpochBarrier antes de aguardar a próxima percepção.
+ *
+ * O encerramento é cooperativo pela variável global `is_running` (SIGINT): todas as esperas
+ * têm tempo limite curto. Para cada thread é registrada a latência recebimento→envio (do `pump`
+ * ao fim do `send`), exatamente como no TeamReactor do run_full_team (single-thread) e impressa nas
+ * mesmas colunas, além do tempo de "pensar".
+ */
+class TeamScheduler {
+public:
+    /**
+     * @struct Worker
+     * @brief Estatísticas de uma thread de agente.
+     */
+    struct Worker {
+        int core = -1;                  ///< Núcleo fixado (-1 se sem afinidade)
+        uint64_t cycles = 0;            ///< Ciclos respondidos
+        uint64_t barrier_timeouts = 0;  ///< Esperas na barreira que esgotaram o tempo limite
+        CycleLatency latency;           ///< Início do `pump` → fim do `send` (a mesma medida do TeamReactor)
+        Histogram think_ns;             ///< Duração da lógica do agente (percepção interpretada → pronto para enviar)
+    };
+
+    ///< Espera máxima de uma thread por seus parceiros na barreira (um ciclo do servidor)
+    static constexpr std::chrono::microseconds BARRIER_TIMEOUT{20'000};
+    ///< Espera máxima no epoll antes de reavaliar `is_running`
+    static constexpr int POLL_TIMEOUT_MS = 100;
+
+private:
+    std::vector<int> __cores;
+    std::vector<Worker> __workers;
+    EpochBarrier __barrier;
+
+    /**
+     * @brief Fixa a thread atual em um núcleo.
+     * @return False se o sistema recusar a afinidade (a thread segue sem ela).
+     */
+    static bool __pin(int core) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+
+    /**
+     * @brief Laço de uma thread: recebe → pensa → envia → barreira.
+     */
+    template<typename Think>
+    void __loop(size_t index, BasePlayer& player, Think& think) {
+        using Clock = std::chrono::steady_clock;
+        Worker& worker = this->__workers[index];
+
+        if(worker.core >= 0 && !__pin(worker.core)){
+            std::cerr << "[TeamScheduler] Nao foi possivel fixar o agente " << index << " no nucleo " << worker.core << std::endl;
+            worker.core = -1;
+        }
+
+        ServerComm& scom = player._scom;
+        scom.set_blocking(False);
+        Poller poller;
+        poller.add(scom.fd(), &player);
+
+        uint64_t arrived_at = UINT64_MAX;
+
+        while(::is_running){
+            if(poller.wait(POLL_TIMEOUT_MS) == 0){ continue; }
+
+            Clock::time_point pumped = Clock::now();
+            int frames = scom.pump();
+            if(frames < 0){ break; } // Servidor encerrou este agente
+            if(frames == 0){ continue; } // Frame ainda incompleto
+
+            Clock::time_point start = Clock::now();
+            think(index, player);
+            worker.think_ns.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+            scom.send();
+            worker.latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - pumped).count());
+            worker.cycles++;
+
+            if(!this->__barrier.arrive_and_wait(arrived_at, BARRIER_TIMEOUT) && ::is_running){ worker.barrier_timeouts++; }
+        }
+
+        this->__barrier.leave(arrived_at);
+    }
+
+public:
+    /**
+     * @brief Define a afinidade das threads.
+     * @param cores Núcleos disponíveis; o agente `i` é fixado em `cores[i % cores.size()]`.
+     * Vazio: sem afinidade (o escalonador do sistema decide).
+     */
+    explicit TeamScheduler(std::vector<int> cores = {}) : __cores(std::move(cores)) {}
+
+    /**
+     * @brief Executa uma thread por agente até o encerramento (SIGINT ou fim das conexões).
+     * @details Os agentes já devem ter concluído o handshake (ver TeamBootstrapper).
+     * @tparam Think Invocável `void(size_t index, BasePlayer& player)`, chamado a cada percepção.
+     * Executa concorrentemente em todas as threads: o que for compartilhado entre agentes precisa de sincronização.
+     * @param players Agentes do time; devem permanecer no mesmo endereço durante a execução.
+     * @param think Lógica de decisão dos agentes.
+     */
+    template<typename Think>
+    void
+    run(std::deque<BasePlayer>& players, Think&& think){
+        this->__workers.assign(players.size(), Worker{});
+        for(size_t i = 0; i < players.size() && !this->__cores.empty(); i++){
+            this->__workers[i].core = this->__cores[i % this->__cores.size()];
+        }
+        this->__barrier.reset(uint32_t(players.size()));
+
+        std::vector<std::thread> threads;
+        threads.reserve(players.size());
+        for(size_t i = 0; i < players.size(); i++){
+            threads.emplace_back([this, i, &players, &think](){ this->__loop(i, players[i], think); });
+        }
+
+        for(auto& t : threads){
+            if(t.joinable()){ t.join(); }
+        }
+    }
+
+    /**
+     * @brief Ciclos liberados pela barreira.
+     */
+    uint64_t
+    epochs() const { return this->__barrier.epoch(); }
+
+    /**
+     * @brief Estatísticas da thread do agente de índice `index`.
+     */
+    const Worker&
+    worker(size_t index) const { return this->__workers[index]; }
+
+    /**
+     * @brief Imprime a latência recebimento→envio por thread, nas colunas do TeamReactor::print_report,
+     * seguida do núcleo, dos percentis do tempo de pensar (p50, p99, max) e das esperas esgotadas na barreira.
+     */
+    void
+    print_report() const {
+        std::printf("\n=== TeamScheduler: latencia recebimento -> envio (us), %llu ciclos alinhados ===\n", (unsigned long long)this->epochs());
+        std::printf("%-6s %10s %10s %10s %10s %8s %6s %10s %10s %10s %10s\n", "agente", "ciclos", "p50", "p99", "max", ">20ms", "nucleo", "pensar p50", "pensar p99", "pensar max", "barreira");
+        for(size_t i = 0; i < this->__workers.size(); i++){
+            const Worker& w = this->__workers[i];
+            const CycleLatency& lat = w.latency;
+            std::printf(
+                "%-6zu %10llu %10.2f %10.2f %10.2f %8llu %6d %10.2f %10.2f %10.2f %10llu\n",
+                i,
+                (unsigned long long)w.cycles,
+                lat.ns.percentile(50) / 1e3,
+                lat.ns.percentile(99) / 1e3,
+                lat.ns.max() / 1e3,
+                (unsigned long long)lat.over_budget,
+                w.core,
+                w.think_ns.percentile(50) / 1e3,
+                w.think_ns.percentile(99) / 1e3,
+                w.think_ns.max() / 1e3,
+                (unsigned long long)w.barrier_timeouts
+            );
+        }
+    }
+};
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <algorithm>
+#include <bit>
+
+/**
+ * @class Histogram
+ * @brief Histograma log-linear no estilo HDR para valores inteiros não-negativos.
+ * @details
+ * Cada potência de 2 é dividida em 16 sub-faixas lineares, o que garante erro relativo
+ * de no máximo ~6% em qualquer percentil, com memória fixa (1 KB de contadores de 32 bits
+ * por faixa de 64 potências) e registro O(1): apenas um `bit_width` e um incremento.
+ * Valores abaixo de 16 são contados exatamente.
+ */
+class Histogram {
+private:
+    static constexpr int SUB_BITS = 4;                       ///< log2 das sub-faixas por potência
+    static constexpr int SUB_COUNT = 1 << SUB_BITS;          ///< 16 sub-faixas
+    static constexpr int BUCKETS = (64 - SUB_BITS + 1) * SUB_COUNT;
+
+    std::array<uint32_t, BUCKETS> __counts{};
+    uint64_t __count = 0;
+    uint64_t __total = 0;
+    uint64_t __min = std::numeric_limits<uint64_t>::max();
+    uint64_t __max = 0;
+
+    /**
+     * @brief Índice do balde de um valor.
+     */
+    static int __index(uint64_t value) {
+        int width = std::bit_width(value);
+        if(width <= SUB_BITS){ return int(value); } // Valores pequenos: um balde por valor
+        int shift = width - SUB_BITS - 1;
+        return (shift + 1) * SUB_COUNT + int((value >> shift) & (SUB_COUNT - 1));
+    }
+
+    /**
+     * @brief Maior valor representado por um balde (limite superior da faixa).
+     */
+    static uint64_t __upper(int index) {
+        if(index < SUB_COUNT){ return uint64_t(index); }
+        int shift = index / SUB_COUNT - 1;
+        uint64_t base = (uint64_t(SUB_COUNT) | uint64_t(index % SUB_COUNT)) << shift;
+        return base + ((uint64_t(1) << shift) - 1);
+    }
+
+public:
+    /**
+     * @brief Registra um valor.
+     */
+    void record(uint64_t value) {
+        this->__counts[__index(value)]++;
+        this->__count++;
+        this->__total += value;
+        if(value < this->__min){ this->__min = value; }
+        if(value > this->__max){ this->__max = value; }
+    }
+
+    uint64_t count() const { return this->__count; }
+    uint64_t min() const { return (this->__count == 0) ? 0 : this->__min; }
+    uint64_t max() const { return this->__max; }
+    double mean() const { return (this->__count == 0) ? 0.0 : double(this->__total) / double(this->__count); }
+
+    /**
+     * @brief Valor abaixo do qual estão `p`% das amostras (limitado ao máximo observado).
+     * @param p Percentil em [0, 100].
+     */
+    uint64_t percentile(double p) const {
+        if(this->__count == 0){ return 0; }
+        uint64_t rank = uint64_t(p / 100.0 * double(this->__count) + 0.5);
+        if(rank == 0){ rank = 1; }
+
+        uint64_t seen = 0;
+        for(int i = 0; i < BUCKETS; i++){
+            seen += this->__counts[i];
+            if(seen >= rank){ return std::min(__upper(i), this->__max); }
+        }
+        return this->__max;
+    }
+
+    /**
+     * @brief Acumula as amostras de outro histograma (ex: consolidar o time inteiro).
+     */
+    void merge(const Histogram& other) {
+        for(int i = 0; i < BUCKETS; i++){ this->__counts[i] += other.__counts[i]; }
+        this->__count += other.__count;
+        this->__total += other.__total;
+        if(other.__count > 0){
+            this->__min = std::min(this->__min, other.__min);
+            this->__max = std::max(this->__max, other.__max);
+        }
+    }
+
+    void reset() { *this = Histogram(); }
+};
+
+/**
+ * @struct CycleLatency
+ * @brief Latência recebimento→envio de um agente: do início do seu `pump` ao fim do seu `send` (ns).
+ * @details Registrada da mesma forma pelos dois runtimes (TeamReactor e TeamScheduler), que a
+ * imprimem nas mesmas colunas (p50/p99/max e ciclos acima do orçamento).
+ */
+struct CycleLatency {
+    ///< Duração de um ciclo do servidor rcssserver3d (20 ms).
+    static constexpr uint64_t BUDGET_NS = 20'000'000;
+
+    Histogram ns;               ///< Uma amostra por ciclo respondido
+    uint64_t over_budget = 0;   ///< Ciclos acima do orçamento do servidor
+
+    void record(uint64_t elapsed_ns) {
+        this->ns.record(elapsed_ns);
+        this->over_budget += (elapsed_ns > BUDGET_NS);
+    }
+};
+
+/**
+ * @struct CommStats
+ * @brief Contadores de comunicação de um agente, atualizados pelo ServerComm a cada leitura/envio.
+ * @details Tudo é alocado junto ao ServerComm: registrar uma amostra não aloca nem faz syscalls.
+ */
+struct CommStats {
+    ///< Duração nominal de um ciclo do servidor, em microssegundos
+    static constexpr uint64_t CYCLE_US = 20'000;
+
+    uint64_t receives = 0;        ///< Chamadas que entregaram ao menos um frame
+    uint64_t frames = 0;          ///< Frames completos recebidos
+    uint64_t dropped = 0;         ///< Frames não interpretados: drenagem (só o mais recente é lido) ou anel cheio
+    uint64_t bytes = 0;           ///< Bytes recebidos do servidor
+    uint64_t sends = 0;           ///< Respostas enviadas com send()
+    uint64_t missed_cycles = 0;   ///< Ciclos do servidor pulados, estimados pelo salto de time_server
+
+    Histogram drained;            ///< Frames drenados por entrega
+    Histogram arrival_to_send_ns; ///< Chegada do frame → send() correspondente
+    Histogram server_gap_us;      ///< Diferença de time_server entre frames interpretados
+
+    /**
+     * @struct Snapshot
+     * @brief Cópia resumida e barata dos contadores (sem os baldes dos histogramas).
+     */
+    struct Snapshot {
+        uint64_t receives, frames, dropped, bytes, sends, missed_cycles;
+        uint64_t drained_max;
+        uint64_t latency_p50_ns, latency_p99_ns, latency_max_ns;
+        uint64_t gap_p50_us, gap_p99_us, gap_max_us;
+    };
+
+    /**
+     * @brief Registra o salto de tempo do servidor entre dois frames interpretados.
+     * @param gap_us Diferença de time_server, em microssegundos.
+     */
+    void record_gap(uint64_t gap_us) {
+        this->server_gap_us.record(gap_us);
+        // Um salto de 40 ms significa um ciclo perdido (arredondando ao ciclo mais próximo)
+        uint64_t cycles = (gap_us + CYCLE_US / 2) / CYCLE_US;
+        if(cycles > 1){ this->missed_cycles += cycles - 1; }
+    }
+
+    /**
+     * @brief Resumo dos contadores.
+     */
+    Snapshot snapshot() const {
+        return {
+            this->receives, this->frames, this->dropped, this->bytes, this->sends, this->missed_cycles,
+            this->drained.max(),
+            this->arrival_to_send_ns.percentile(50), this->arrival_to_send_ns.percentile(99), this->arrival_to_send_ns.max(),
+            this->server_gap_us.percentile(50), this->server_gap_us.percentile(99), this->server_gap_us.max()
+        };
+    }
+
+    /**
+     * @brief Cabeçalho da tabela impressa por `print_row`.
+     */
+    static void print_header() {
+        std::printf("\n=== ServerComm: recebimento por agente ===\n");
+        std::printf("%-5s %8s %8s %8s %10s %8s %9s %9s %9s %9s %9s\n",
+                    "unum", "frames", "drop", "drenMax", "KB", "perdidos",
+                    "p50(us)", "p99(us)", "max(us)", "gap p99", "gap max");
+    }
+
+    /**
+     * @brief Imprime uma linha da tabela com o resumo deste agente.
+     */
+    void print_row(int unum) const {
+        Snapshot s = this->snapshot();
+        std::printf("%-5d %8llu %8llu %8llu %10.1f %8llu %9.1f %9.1f %9.1f %7.1fms %7.1fms\n",
+                    unum,
+                    (unsigned long long)s.frames, (unsigned long long)s.dropped, (unsigned long long)s.drained_max,
+                    s.bytes / 1024.0, (unsigned long long)s.missed_cycles,
+                    s.latency_p50_ns / 1e3, s.latency_p99_ns / 1e3, s.latency_max_ns / 1e3,
+                    s.gap_p99_us / 1e3, s.gap_max_us / 1e3);
+    }
+};
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <array>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+/**
+ * @enum Effector
+ * @brief Efetores de junta do NAO, na mesma ordem em que o servidor envia as juntas (HJ).
+ * @details Assim, o índice de uma junta percebida é também o índice do efetor que a move.
+ */
+enum class Effector : uint8_t {
+    HE1, HE2,
+    RAE1, RAE2, RAE3, RAE4,
+    LAE1, LAE2, LAE3, LAE4,
+    RLE1, RLE2, RLE3, RLE4, RLE5, RLE6,
+    LLE1, LLE2, LLE3, LLE4, LLE5, LLE6,
+    COUNT
+};
+
+///< Quantidade de efetores de junta
+inline constexpr size_t EFFECTOR_COUNT = size_t(Effector::COUNT);
+
+/**
+ * @brief Prefixos prontos de cada efetor ("(he1 "), resolvidos em tempo de compilação.
+ */
+inline constexpr std::array<std::string_view, EFFECTOR_COUNT> EFFECTOR_PREFIX = {
+    "(he1 ", "(he2 ",
+    "(rae1 ", "(rae2 ", "(rae3 ", "(rae4 ",
+    "(lae1 ", "(lae2 ", "(lae3 ", "(lae4 ",
+    "(rle1 ", "(rle2 ", "(rle3 ", "(rle4 ", "(rle5 ", "(rle6 ",
+    "(lle1 ", "(lle2 ", "(lle3 ", "(lle4 ", "(lle5 ", "(lle6 "
+};
+
+/**
+ * @brief Escreve um inteiro em decimal a partir de `dst`.
+ * @return Ponteiro para o primeiro byte após o número.
+ */
+inline char* write_int(char* dst, int64_t value) {
+    uint64_t magnitude = (value < 0) ? uint64_t(-(value + 1)) + 1 : uint64_t(value);
+    if(value < 0){ *dst++ = '-'; }
+
+    char digits[20];
+    int n = 0;
+    do { digits[n++] = char('0' + magnitude % 10); magnitude /= 10; } while(magnitude != 0);
+    while(n > 0){ *dst++ = digits[--n]; }
+    return dst;
+}
+
+/**
+ * @brief Escreve um float com quantidade fixa de casas decimais (arredondamento ao mais próximo).
+ * @details Substitui `std::format`/`snprintf` no caminho de envio: apenas aritmética inteira,
+ * sem locale e sem alocação. Valores são limitados a ±1e9; NaN é escrito como 0.
+ * @param dst Destino (ao menos 12 + decimals bytes livres).
+ * @param value Valor a ser escrito.
+ * @param decimals Casas decimais, de 0 a 6.
+ * @return Ponteiro para o primeiro byte após o número.
+ */
+inline char* write_fixed(char* dst, float value, int decimals = 2) {
+    static constexpr uint32_t POW10[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+    if(value != value){ *dst++ = '0'; return dst; } // NaN
+    bool negative = value < 0.0f;
+    double magnitude = negative ? -double(value) : double(value);
+    if(magnitude > 1e9){ magnitude = 1e9; }
+
+    uint64_t scaled = uint64_t(magnitude * POW10[decimals] + 0.5);
+    if(negative && scaled != 0){ *dst++ = '-'; } // Nada de "-0.00"
+
+    dst = write_int(dst, int64_t(scaled / POW10[decimals]));
+    if(decimals > 0){
+        uint64_t fraction = scaled % POW10[decimals];
+        *dst++ = '.';
+        for(int i = decimals - 1; i >= 0; i--){ dst[i] = char('0' + fraction % 10); fraction /= 10; }
+        dst += decimals;
+    }
+    return dst;
+}
+
+/**
+ * @class CommandBuilder
+ * @brief Escreve comandos de efetores diretamente no buffer de envio do agente.
+ * @details
+ * Cada comando é montado em um pequeno buffer na pilha e acrescentado ao buffer de envio,
+ * já reservado na inicialização do ServerComm: não há strings temporárias nem alocações
+ * por ciclo, mesmo enviando as 22 velocidades de junta.
+ *
+ * Uso: `scom.commands().joint(Effector::HE1, 1.5f).beam(-0.5f, 10.0f, 0.0f);`
+ */
+class CommandBuilder {
+private:
+    std::string& __out;   ///< Buffer de destino (o buffer de envio do ServerComm)
+    int __decimals;       ///< Casas decimais dos valores de ponto flutuante
+
+    /**
+     * @brief Acrescenta ao destino o trecho [begin, end) do buffer temporário.
+     */
+    CommandBuilder& __flush(const char* begin, const char* end) {
+        this->__out.append(begin, size_t(end - begin));
+        return *this;
+    }
+
+    /**
+     * @brief Copia um trecho de texto constante para `dst`.
+     */
+    static char* __put(char* dst, std::string_view text) {
+        for(char c : text){ *dst++ = c; }
+        return dst;
+    }
+
+public:
+    /**
+     * @param out Buffer de destino, já reservado.
+     * @param decimals Casas decimais dos valores (2 por padrão, precisão de 0.01).
+     */
+    explicit CommandBuilder(std::string& out, int decimals = 2) : __out(out), __decimals(decimals) {}
+
+    /**
+     * @brief Velocidade de uma junta: `(he1 1.50)`.
+     */
+    CommandBuilder& joint(Effector effector, float speed) {
+        char tmp[48];
+        char* p = __put(tmp, EFFECTOR_PREFIX[size_t(effector)]);
+        p = write_fixed(p, speed, this->__decimals);
+        *p++ = ')';
+        return this->__flush(tmp, p);
+    }
+
+    /**
+     * @brief Velocidades das 22 juntas de uma vez, na ordem de `Effector`.
+     */
+    CommandBuilder& joints(const std::array<float, EFFECTOR_COUNT>& speeds) {
+        char tmp[EFFECTOR_COUNT * 32];
+        char* p = tmp;
+        for(size_t i = 0; i < EFFECTOR_COUNT; i++){
+            p = __put(p, EFFECTOR_PREFIX[i]);
+            p = write_fixed(p, speeds[i], this->__decimals);
+            *p++ = ')';
+        }
+        return this->__flush(tmp, p);
+    }
+
+    /**
+     * @brief Posicionamento direto no campo: `(beam x y rot)`.
+     */
+    CommandBuilder& beam(float x, float y, float rotation) {
+        char tmp[96];
+        char* p = __put(tmp, "(beam ");
+        p = write_fixed(p, x, this->__decimals);
+        *p++ = ' ';
+        p = write_fixed(p, y, this->__decimals);
+        *p++ = ' ';
+        p = write_fixed(p, rotation, this->__decimals);
+        *p++ = ')';
+        return this->__flush(tmp, p);
+    }
+
+    /**
+     * @brief Mensagem aos companheiros: `(say msg)`.
+     * @details O servidor aceita até 20 caracteres ASCII imprimíveis, exceto espaço e parênteses.
+     */
+    CommandBuilder& say(std::string_view message) {
+        this->__out.append("(say ");
+        this->__out.append(message);
+        this->__out.push_back(')');
+        return *this;
+    }
+
+    /**
+     * @brief Modelo do robô: `(scene rsg/agent/nao/nao_hetero.rsg tipo)`.
+     */
+    CommandBuilder& scene(int robot_type) {
+        char tmp[64];
+        char* p = __put(tmp, "(scene rsg/agent/nao/nao_hetero.rsg ");
+        p = write_int(p, robot_type);
+        *p++ = ')';
+        return this->__flush(tmp, p);
+    }
+
+    /**
+     * @brief Time e número: `(init (unum n) (teamname nome))`.
+     */
+    CommandBuilder& init(int unum, std::string_view team_name) {
+        char tmp[64];
+        char* p = __put(tmp, "(init (unum ");
+        p = write_int(p, unum);
+        p = __put(p, ") (teamname ");
+        this->__flush(tmp, p);
+        this->__out.append(team_name);
+        this->__out.append("))");
+        return *this;
+    }
+
+    /**
+     * @brief Modo de passe: `(pass_mode)`.
+     */
+    CommandBuilder& pass_mode() {
+        this->__out.append("(pass_mode)");
+        return *this;
+    }
+
+    /**
+     * @brief Fim do ciclo de comandos: `(syn)`.
+     */
+    CommandBuilder& syn() {
+        this->__out.append("(syn)");
+        return *this;
+    }
+};
@@ -0,0 +1,274 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <algorithm>
+#include <utility>
+
+// --- Bibliotecas de Sistema (POSIX) ---
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <arpa/inet.h>
+
+/**
+ * @class FrameDecoder
+ * @brief Enquadrador de fluxo para o protocolo do rcssserver3d (`[4 bytes de tamanho][corpo]`).
+ * @details
+ * Os bytes do socket são depositados em um buffer circular com um único `recvmsg` por vez,
+ * preenchendo de uma só vez o espaço livre do final e do início do anel (scatter).
+ * Os limites dos frames são encontrados no próprio anel, sem cópia: o frame mais recente
+ * é entregue como `std::string_view` apontando para dentro do anel.
+ *
+ * Frames que dão a volta no anel são linearizados em um buffer auxiliar (única cópia possível),
+ * e frames maiores que a capacidade fazem o anel crescer para a próxima potência de 2.
+ *
+ * Toda view entregue é seguida de um '\0' (fora do tamanho da view). Quando nada foi recebido
+ * depois do frame, o terminador ocupa o espaço livre seguinte do anel (há um byte extra ao fim
+ * da memória para o frame que termina exatamente na borda); quando há bytes depois dele,
+ * o frame é copiado para o buffer auxiliar, pois o byte seguinte pertence ao próximo frame.
+ *
+ * Com o anel cheio, `latest` descarta os frames completos já superados (contados em `take_discarded`).
+ * Após a primeira chamada de `next`, nenhum frame é descartado: o anel cresce até que sejam consumidos.
+ *
+ * A view devolvida por `latest` permanece válida até a próxima chamada de `fill` ou `append`.
+ */
+class FrameDecoder {
+private:
+    std::vector<char> __ring;      ///< Memória do anel (capacidade potência de 2, mais o byte do terminador)
+    size_t __mask;                 ///< Capacidade - 1, para o módulo barato
+    uint64_t __head = 0;           ///< Posição absoluta de leitura (início do próximo frame)
+    uint64_t __tail = 0;           ///< Posição absoluta de escrita
+    std::vector<char> __scratch;   ///< Linearização de frames que cruzam o fim do anel
+    uint64_t __discarded = 0;      ///< Frames completos descartados pelo anel cheio, ainda não consultados
+    bool __keep_all = False;       ///< True após o primeiro `next`: o anel cresce em vez de descartar
+
+    /**
+     * @brief Lê o cabeçalho de 4 bytes na posição absoluta `pos`, mesmo que cruze o fim do anel.
+     */
+    uint32_t __peek_length(uint64_t pos) const {
+        uint32_t net_len;
+        char* dst = reinterpret_cast<char*>(&net_len);
+        for(int i = 0; i < 4; i++){ dst[i] = this->__ring[(pos + i) & this->__mask]; }
+        return ntohl(net_len);
+    }
+
+    /**
+     * @brief Dobra a capacidade do anel até comportar `needed` bytes, preservando o conteúdo.
+     * @details Caminho raro (mensagens maiores que o anel); fora dele não há alocações.
+     */
+    void __grow(size_t needed) {
+        size_t capacity = this->capacity();
+        while(capacity < needed){ capacity *= 2; }
+
+        std::vector<char> bigger(capacity + 1);
+        size_t used = this->size();
+        this->__copy_out(this->__head, bigger.data(), used);
+
+        this->__ring.swap(bigger);
+        this->__mask = capacity - 1;
+        this->__head = 0;
+        this->__tail = used;
+    }
+
+    /**
+     * @brief Copia `len` bytes a partir da posição absoluta `pos` para `dst`, tratando a volta do anel.
+     */
+    void __copy_out(uint64_t pos, char* dst, size_t len) const {
+        size_t start = pos & this->__mask;
+        size_t first = std::min(len, this->capacity() - start);
+        std::memcpy(dst, this->__ring.data() + start, first);
+        std::memcpy(dst + first, this->__ring.data(), len - first);
+    }
+
+    /**
+     * @brief View terminada em '\0' para o corpo de um frame já consumido.
+     * @details Aponta para o anel se o frame não cruzar o fim e for o último recebido (o byte seguinte
+     * está livre); senão, para o buffer auxiliar.
+     */
+    std::string_view __view(uint64_t body, uint32_t body_len) {
+        size_t start = body & this->__mask;
+        if(start + body_len <= this->capacity() && body + body_len == this->__tail){
+            this->__ring[start + body_len] = '\0'; // Espaço livre, ou o byte extra ao fim do anel
+            return std::string_view(this->__ring.data() + start, body_len);
+        }
+        this->__scratch.resize(size_t(body_len) + 1);
+        this->__copy_out(body, this->__scratch.data(), body_len);
+        this->__scratch[body_len] = '\0';
+        return std::string_view(this->__scratch.data(), body_len);
+    }
+
+    /**
+     * @brief Garante ao menos `wanted` bytes livres antes de uma escrita no anel.
+     * @details Fora do modo `next`, descarta frames completos já superados (mantendo o mais recente,
+     * contando os demais em `__discarded`) e, se ainda assim o anel estiver cheio, o faz crescer
+     * (ao menos até caber o frame em curso).
+     */
+    void __make_room(size_t wanted = 1) {
+        if(this->free_space() >= wanted){ return; }
+
+        if(!this->__keep_all){
+            // Mantém apenas o último frame completo e o frame parcial seguinte
+            uint64_t latest = this->__head;
+            uint64_t pos = this->__head;
+            uint64_t complete = 0;
+            while(this->__tail - pos >= 4){
+                uint64_t next = pos + 4 + this->__peek_length(pos);
+                if(next > this->__tail){ break; }
+                latest = pos;
+                pos = next;
+                complete++;
+            }
+            if(complete > 1){ this->__discarded += complete - 1; }
+            this->__head = latest;
+            if(this->free_space() >= wanted){ return; }
+        }
+
+        // Frame maior que o anel (ou nada a descartar): crescemos de uma vez para o tamanho anunciado no cabeçalho
+        size_t needed = (this->size() >= 4) ? size_t(this->__peek_length(this->__head)) + 4 : 0;
+        this->__grow(std::max({needed, this->size() + wanted, this->capacity() * 2}));
+    }
+
+public:
+    /**
+     * @brief Aloca o anel na inicialização.
+     * @param capacity Capacidade inicial em bytes (arredondada para potência de 2).
+     */
+    explicit FrameDecoder(size_t capacity = 65536) {
+        size_t pow2 = 1;
+        while(pow2 < capacity){ pow2 *= 2; }
+        this->__ring.resize(pow2 + 1);
+        this->__mask = pow2 - 1;
+        this->__scratch.reserve(4096);
+    }
+
+    /**
+     * @brief Capacidade atual do anel, em bytes.
+     */
+    size_t capacity() const { return this->__mask + 1; }
+
+    /**
+     * @brief Bytes acumulados ainda não consumidos.
+     */
+    size_t size() const { return size_t(this->__tail - this->__head); }
+
+    /**
+     * @brief Espaço livre no anel.
+     */
+    size_t free_space() const { return this->capacity() - this->size(); }
+
+    /**
+     * @brief Preenche o anel com uma única leitura do socket.
+     * @details Usa `recvmsg` com até dois iovecs (fim e início do anel), de modo que uma só
+     * syscall aproveita todo o espaço livre, mesmo quando ele dá a volta.
+     * @param fd Socket de origem.
+     * @param flags Flags do `recvmsg` (ex: MSG_DONTWAIT para nunca bloquear).
+     * @return Bytes lidos, 0 em EOF ou -1 em erro/timeout (ver errno).
+     */
+    ssize_t fill(int fd, int flags = 0) {
+        this->__make_room();
+
+        size_t start = this->__tail & this->__mask;
+        size_t free_space = this->free_space();
+        size_t first = std::min(free_space, this->capacity() - start);
+
+        struct iovec iov[2];
+        iov[0].iov_base = this->__ring.data() + start;
+        iov[0].iov_len  = first;
+        iov[1].iov_base = this->__ring.data();
+        iov[1].iov_len  = free_space - first;
+
+        struct msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = (iov[1].iov_len > 0) ? 2 : 1;
+
+        ssize_t bytes = ::recvmsg(fd, &msg, flags);
+        if(bytes > 0){ this->__tail += bytes; }
+        return bytes;
+    }
+
+    /**
+     * @brief Acrescenta bytes vindos de outra fonte (ex: buffers do io_uring).
+     */
+    void append(const char* data, size_t len) {
+        this->__make_room(len);
+
+        size_t start = this->__tail & this->__mask;
+        size_t first = std::min(len, this->capacity() - start);
+        std::memcpy(this->__ring.data() + start, data, first);
+        std::memcpy(this->__ring.data(), data + first, len - first);
+        this->__tail += len;
+    }
+
+    /**
+     * @brief Verifica se há ao menos um frame completo no anel.
+     */
+    bool has_frame() const {
+        if(this->size() < 4){ return False; }
+        return this->size() - 4 >= this->__peek_length(this->__head);
+    }
+
+    /**
+     * @brief Desliga o descarte de frames desde já, antes mesmo do primeiro `next`.
+     * @details Para quem lê o socket várias vezes antes de consumir (ex: MockServer, gravação).
+     */
+    void keep_all() { this->__keep_all = True; }
+
+    /**
+     * @brief Frames completos descartados pelo anel cheio desde a última consulta (nunca entregues).
+     */
+    uint64_t take_discarded() { return std::exchange(this->__discarded, 0); }
+
+    /**
+     * @brief Localiza o frame completo mais recente e descarta os anteriores, sem copiá-los.
+     * @details Um frame parcial ao final é preservado para a próxima leitura. Se o frame mais
+     * recente cruzar o fim do anel (ou for seguido de um frame parcial), ele é copiado para o buffer auxiliar.
+     * @param[out] out View para o corpo do frame mais recente (válida até o próximo fill/append).
+     * @return Quantidade de frames completos consumidos (0 se nenhum).
+     */
+    int latest(std::string_view& out) {
+        uint64_t pos = this->__head;
+        uint64_t body = 0;
+        uint32_t body_len = 0;
+        int frames = 0;
+
+        while(this->__tail - pos >= 4){
+            uint32_t msg_len = this->__peek_length(pos);
+            if(this->__tail - pos - 4 < msg_len){ break; } // Frame incompleto
+
+            body = pos + 4;
+            body_len = msg_len;
+            pos += 4 + msg_len;
+            frames++;
+        }
+
+        if(frames == 0){ return 0; }
+        this->__head = pos;
+
+        out = this->__view(body, body_len);
+        return frames;
+    }
+
+    /**
+     * @brief Consome o frame completo mais antigo, um por vez (sem a estratégia de drenagem).
+     * @details Útil quando toda mensagem importa, como no lado do servidor (MockServer) ou na gravação.
+     * A partir da primeira chamada, o anel não descarta mais frames para abrir espaço: cresce.
+     * @param[out] out View para o corpo do frame (válida até a próxima chamada de next/latest/fill/append).
+     * @return True se havia um frame completo.
+     */
+    bool next(std::string_view& out) {
+        this->__keep_all = True;
+        if(!this->has_frame()){ return False; }
+
+        uint32_t body_len = this->__peek_length(this->__head);
+        uint64_t body = this->__head + 4;
+        this->__head = body + body_len;
+
+        out = this->__view(body, body_len);
+        return True;
+    }
+};
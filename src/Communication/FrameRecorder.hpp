@@ -0,0 +1,280 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <string_view>
+#include <algorithm>
+#include <iostream>
+
+// --- Bibliotecas de Sistema (POSIX) ---
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+ * Formato do arquivo de captura:
+ *
+ *   [CaptureHeader][RecordHeader][corpo][padding] [RecordHeader][corpo][padding] ...
+ *
+ * Cada registro é alinhado em 8 bytes. Um RecordHeader com `length == 0` marca o fim
+ * (o arquivo é pré-alocado com zeros), o que permite ler capturas interrompidas por crash.
+ */
+
+/**
+ * @struct CaptureHeader
+ * @brief Cabeçalho do arquivo de captura.
+ */
+struct CaptureHeader {
+    char magic[8];      ///< "SSRCAP1"
+    uint64_t used;      ///< Bytes de registros após o cabeçalho (atualizado ao fechar)
+};
+
+/**
+ * @struct RecordHeader
+ * @brief Cabeçalho de cada frame gravado.
+ */
+struct RecordHeader {
+    uint64_t timestamp_ns;  ///< Instante de recebimento (CLOCK_MONOTONIC)
+    uint32_t length;        ///< Tamanho do corpo, sem o cabeçalho de 4 bytes do protocolo
+    uint16_t unum;          ///< Agente que recebeu o frame
+    uint16_t reserved;
+};
+
+inline constexpr char CAPTURE_MAGIC[8] = "SSRCAP1";
+
+/**
+ * @brief Tamanho ocupado por um registro de `length` bytes de corpo, já alinhado.
+ */
+inline constexpr size_t capture_record_size(size_t length) {
+    return (sizeof(RecordHeader) + length + 7) & ~size_t(7);
+}
+
+/**
+ * @class FrameRecorder
+ * @brief Grava os frames brutos do servidor em um arquivo mapeado em memória (somente acréscimo).
+ * @details
+ * O arquivo é criado e mapeado com a capacidade total na inicialização, de modo que gravar um
+ * frame é apenas reservar espaço com um `fetch_add` atômico e copiar os bytes: sem syscalls e
+ * sem locks, mesmo com vários agentes (ou threads) gravando no mesmo arquivo.
+ *
+ * Frames que não couberem na capacidade são descartados e contabilizados em `dropped()`, assim
+ * como os que o chamador informar em `count_dropped` (ex: perdidos antes de chegarem à gravação).
+ *
+ * A capacidade padrão comporta uma partida inteira de 11 agentes. O arquivo é esparso: só ocupa
+ * disco o que for gravado, e `close` o reduz ao tamanho usado. Ver FrameReplayer para a leitura.
+ */
+class FrameRecorder {
+private:
+    int __fd = -1;
+    char* __map = nullptr;
+    size_t __capacity = 0;                   ///< Bytes disponíveis para registros
+    std::atomic<uint64_t> __offset{0};       ///< Próxima posição livre (após o cabeçalho)
+    std::atomic<uint64_t> __frames{0};
+    std::atomic<uint64_t> __dropped{0};
+
+public:
+    ///< Uma partida de 11 agentes: 2 tempos x 300 s x 50 ciclos/s x 11 agentes x ~1.5 KB ≈ 500 MB
+    static constexpr size_t MATCH_CAPACITY = size_t(640) << 20;
+
+private:
+
+    /**
+     * @brief Instante atual em nanossegundos (CLOCK_MONOTONIC).
+     */
+    static uint64_t __now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    }
+
+public:
+    FrameRecorder() = default;
+    FrameRecorder(const FrameRecorder&) = delete;
+    void operator=(const FrameRecorder&) = delete;
+
+    ~FrameRecorder() { this->close(); }
+
+    /**
+     * @brief Cria o arquivo de captura e o mapeia com a capacidade total.
+     * @param path Caminho do arquivo (sobrescrito se existir).
+     * @param capacity Bytes reservados para registros (~1.5 KB por frame; o dobro do padrão em self-play).
+     * @return False se o arquivo não pôde ser criado ou mapeado.
+     */
+    bool open(const char* path, size_t capacity = MATCH_CAPACITY) {
+        this->__fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if(this->__fd < 0){ return False; }
+
+        size_t total = sizeof(CaptureHeader) + capacity;
+        if(ftruncate(this->__fd, off_t(total)) != 0){
+            ::close(this->__fd);
+            this->__fd = -1;
+            return False;
+        }
+
+        void* map = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, this->__fd, 0);
+        if(map == MAP_FAILED){
+            ::close(this->__fd);
+            this->__fd = -1;
+            return False;
+        }
+
+        this->__map = static_cast<char*>(map);
+        this->__capacity = capacity;
+        this->__offset = 0;
+
+        CaptureHeader* header = reinterpret_cast<CaptureHeader*>(this->__map);
+        std::memcpy(header->magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC));
+        header->used = 0;
+        return True;
+    }
+
+    /**
+     * @brief Indica se há um arquivo de captura aberto.
+     */
+    bool is_open() const { return this->__map != nullptr; }
+
+    /**
+     * @brief Acrescenta um frame à captura. Seguro para chamadas concorrentes.
+     * @param unum Agente que recebeu o frame.
+     * @param frame Corpo do frame, sem o cabeçalho de tamanho.
+     * @return False se não havia espaço (o frame é descartado).
+     */
+    bool record(int unum, std::string_view frame) {
+        if(this->__map == nullptr){ return False; }
+
+        size_t size = capture_record_size(frame.size());
+        uint64_t offset = this->__offset.fetch_add(size, std::memory_order_relaxed);
+        if(offset + size > this->__capacity){
+            this->__dropped.fetch_add(1, std::memory_order_relaxed);
+            return False;
+        }
+
+        char* dst = this->__map + sizeof(CaptureHeader) + offset;
+        RecordHeader record{this->__now_ns(), uint32_t(frame.size()), uint16_t(unum), 0};
+        std::memcpy(dst + sizeof(RecordHeader), frame.data(), frame.size());
+        std::memcpy(dst, &record, sizeof(RecordHeader));
+
+        this->__frames.fetch_add(1, std::memory_order_relaxed);
+        return True;
+    }
+
+    /**
+     * @brief Frames gravados até o momento.
+     */
+    uint64_t frames() const { return this->__frames.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Contabiliza frames que não chegaram a ser gravados. Seguro para chamadas concorrentes.
+     */
+    void count_dropped(uint64_t frames) { this->__dropped.fetch_add(frames, std::memory_order_relaxed); }
+
+    /**
+     * @brief Frames descartados: por falta de capacidade ou informados em `count_dropped`.
+     */
+    uint64_t dropped() const { return this->__dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Registra o tamanho final, desfaz o mapeamento e reduz o arquivo ao espaço usado.
+     */
+    void close() {
+        if(this->__map == nullptr){ return; }
+
+        uint64_t used = std::min<uint64_t>(this->__offset.load(), this->__capacity);
+        // Reservas que estouraram a capacidade não deixam lixo: o espaço além de `used` é descartado
+        reinterpret_cast<CaptureHeader*>(this->__map)->used = used;
+
+        munmap(this->__map, sizeof(CaptureHeader) + this->__capacity);
+        if(ftruncate(this->__fd, off_t(sizeof(CaptureHeader) + used)) != 0){
+            std::cerr << "[FrameRecorder] Falha ao ajustar o tamanho da captura." << std::endl;
+        }
+        ::close(this->__fd);
+
+        this->__map = nullptr;
+        this->__fd = -1;
+    }
+};
+
+/**
+ * @class FrameReplayer
+ * @brief Lê uma captura do FrameRecorder e reproduz seus frames.
+ * @details O arquivo é mapeado somente para leitura: os frames são entregues como
+ * `std::string_view` apontando diretamente para o mapeamento, sem cópias.
+ */
+class FrameReplayer {
+private:
+    int __fd = -1;
+    const char* __map = nullptr;
+    size_t __size = 0;
+
+public:
+    FrameReplayer() = default;
+    FrameReplayer(const FrameReplayer&) = delete;
+    void operator=(const FrameReplayer&) = delete;
+
+    ~FrameReplayer() {
+        if(this->__map != nullptr){ munmap((void*)this->__map, this->__size); }
+        if(this->__fd != -1){ ::close(this->__fd); }
+    }
+
+    /**
+     * @brief Abre e mapeia uma captura.
+     * @return False se o arquivo não existir ou não for uma captura válida.
+     */
+    bool open(const char* path) {
+        this->__fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if(this->__fd < 0){ return False; }
+
+        struct stat st;
+        if(fstat(this->__fd, &st) != 0 || size_t(st.st_size) < sizeof(CaptureHeader)){ return False; }
+        this->__size = size_t(st.st_size);
+
+        void* map = mmap(nullptr, this->__size, PROT_READ, MAP_PRIVATE, this->__fd, 0);
+        if(map == MAP_FAILED){ return False; }
+        this->__map = static_cast<const char*>(map);
+
+        return std::memcmp(this->__map, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) == 0;
+    }
+
+    /**
+     * @brief Percorre os frames na ordem de gravação.
+     * @tparam Sink Invocável `void(int unum, std::string_view frame)`.
+     * @param sink Destino de cada frame (ex: `Environment::update_from_server` do agente).
+     * @param realtime Se True, respeita os intervalos originais entre frames; senão, velocidade máxima.
+     * @return Quantidade de frames reproduzidos.
+     */
+    template<typename Sink>
+    size_t replay(Sink&& sink, bool realtime = False) const {
+        using Clock = std::chrono::steady_clock;
+
+        size_t pos = sizeof(CaptureHeader);
+        size_t count = 0;
+        uint64_t first_ts = 0;
+        Clock::time_point start = Clock::now();
+
+        while(pos + sizeof(RecordHeader) <= this->__size){
+            RecordHeader record;
+            std::memcpy(&record, this->__map + pos, sizeof(RecordHeader));
+            if(record.length == 0 || pos + capture_record_size(record.length) > this->__size){ break; } // Fim da captura
+
+            if(realtime){
+                if(count == 0){ first_ts = record.timestamp_ns; }
+                // Gravações concorrentes podem chegar levemente fora de ordem: nunca esperamos "para trás"
+                int64_t delta = int64_t(record.timestamp_ns - first_ts);
+                if(delta > 0){ std::this_thread::sleep_until(start + std::chrono::nanoseconds(delta)); }
+            }
+
+            sink(int(record.unum), std::string_view(this->__map + pos + sizeof(RecordHeader), record.length));
+            pos += capture_record_size(record.length);
+            count++;
+        }
+        return count;
+    }
+};
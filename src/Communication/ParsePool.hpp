@@ -0,0 +1,187 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @class ParsePool
+ * @brief Pool pequeno de threads que executa um lote de tarefas independentes e espera todas terminarem.
+ * @details
+ * Feito para interpretar as percepções dos agentes de um ciclo em paralelo (ver TeamReactor::run_batch):
+ * poucas tarefas (até 11 ou 22), de poucos microssegundos cada, em que o custo de acordar e juntar as
+ * threads pesa tanto quanto o trabalho.
+ *
+ * Cada participante (as threads do pool e a que chama `run`) recebe um bloco contíguo de tarefas com
+ * seu próprio contador atômico. Ao esgotar o seu bloco, ele rouba tarefas dos blocos dos demais pelo
+ * mesmo contador (`fetch_add`), de modo que um participante atrasado (ex: ainda acordando) não atrasa o lote:
+ * no pior caso, quem chamou `run` executa tudo sozinho.
+ *
+ * As threads esperam por um novo lote girando por pouco tempo e depois dormindo em `std::atomic::wait`.
+ * Com 0 threads, `run` é simplesmente o laço serial.
+ */
+class ParsePool {
+private:
+    /**
+     * @struct Range
+     * @brief Bloco de tarefas de um participante: [next, end).
+     */
+    struct alignas(64) Range {
+        std::atomic<uint32_t> next{0};
+        uint32_t end = 0;
+    };
+
+    using Task = void (*)(void* context, size_t index);
+
+    std::vector<std::thread> __threads;
+    std::unique_ptr<Range[]> __ranges;    ///< Um bloco por participante (threads + quem chama `run`)
+    size_t __participants = 1;
+
+    // Lote atual: válido enquanto `__open`
+    Task __task = nullptr;
+    void* __context = nullptr;
+
+    alignas(64) std::atomic<uint64_t> __generation{0};  ///< Avança a cada lote
+    alignas(64) std::atomic<bool> __open{False};        ///< Lote aceitando participantes
+    alignas(64) std::atomic<uint32_t> __active{0};      ///< Threads dentro do lote atual
+    alignas(64) std::atomic<uint32_t> __done{0};        ///< Tarefas concluídas no lote atual
+    std::atomic<bool> __stopping{False};
+
+    ///< Iterações de espera ativa antes de dormir no `wait`
+    static constexpr uint32_t SPIN = 4096;
+
+    static void __relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    /**
+     * @brief Espera ativa até `done()`, cedendo o núcleo após SPIN iterações (ex: máquina com um só núcleo).
+     */
+    template<typename Done>
+    static void __spin_until(Done&& done) {
+        for(uint32_t spins = 0; !done(); spins++){
+            if(spins < SPIN){ __relax(); }
+            else { std::this_thread::yield(); }
+        }
+    }
+
+    /**
+     * @brief Executa tarefas do próprio bloco e, em seguida, rouba dos demais.
+     */
+    void __work(size_t self) {
+        uint32_t completed = 0;
+        for(size_t k = 0; k < this->__participants; k++){
+            Range& range = this->__ranges[(self + k) % this->__participants];
+            while(True){
+                uint32_t index = range.next.fetch_add(1, std::memory_order_relaxed);
+                if(index >= range.end){ break; }
+                this->__task(this->__context, index);
+                completed++;
+            }
+        }
+        if(completed){ this->__done.fetch_add(completed, std::memory_order_release); }
+    }
+
+    /**
+     * @brief Laço de uma thread do pool.
+     */
+    void __loop(size_t self) {
+        uint64_t seen = 0;
+        while(True){
+            uint64_t generation = this->__generation.load(std::memory_order_acquire);
+            for(uint32_t spins = 0; generation == seen && spins < SPIN; spins++){
+                __relax();
+                generation = this->__generation.load(std::memory_order_acquire);
+            }
+            if(generation == seen){
+                this->__generation.wait(seen, std::memory_order_acquire);
+                continue;
+            }
+            seen = generation;
+            if(this->__stopping.load(std::memory_order_acquire)){ return; }
+
+            // Entra no lote antes de conferir se ele ainda está aberto: quem chamou `run` só retorna
+            // depois de fechar o lote e ver `__active` zerado (ordem sequencialmente consistente)
+            this->__active.fetch_add(1, std::memory_order_seq_cst);
+            if(this->__open.load(std::memory_order_seq_cst)){ this->__work(self); }
+            this->__active.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+public:
+    /**
+     * @param threads Threads auxiliares (0: execução serial na thread que chama `run`).
+     */
+    explicit ParsePool(size_t threads = 0) :
+        __ranges(std::make_unique<Range[]>(threads + 1)),
+        __participants(threads + 1)
+    {
+        this->__threads.reserve(threads);
+        for(size_t t = 0; t < threads; t++){
+            this->__threads.emplace_back([this, t](){ this->__loop(t + 1); });
+        }
+    }
+
+    ~ParsePool() {
+        this->__stopping.store(True, std::memory_order_release);
+        this->__generation.fetch_add(1, std::memory_order_acq_rel);
+        this->__generation.notify_all();
+        for(auto& t : this->__threads){ t.join(); }
+    }
+
+    ParsePool(const ParsePool&) = delete;
+    ParsePool& operator=(const ParsePool&) = delete;
+
+    /**
+     * @brief Quantidade de threads auxiliares.
+     */
+    size_t threads() const { return this->__threads.size(); }
+
+    /**
+     * @brief Executa `fn(i)` para cada `i` em [0, count) e retorna quando todas terminarem.
+     * @details A thread que chama também executa tarefas. Somente uma thread pode chamar `run` por vez.
+     * @tparam Fn Invocável `void(size_t)`; chamadas concorrentes devem tocar dados independentes.
+     */
+    template<typename Fn>
+    void
+    run(size_t count, Fn&& fn){
+        if(this->__threads.empty() || count <= 1){
+            for(size_t i = 0; i < count; i++){ fn(i); }
+            return;
+        }
+
+        using Callable = std::remove_reference_t<Fn>;
+        this->__task = [](void* context, size_t index){ (*static_cast<Callable*>(context))(index); };
+        this->__context = const_cast<void*>(static_cast<const void*>(&fn));
+        for(size_t p = 0; p < this->__participants; p++){
+            this->__ranges[p].next.store(uint32_t(count * p / this->__participants), std::memory_order_relaxed);
+            this->__ranges[p].end = uint32_t(count * (p + 1) / this->__participants);
+        }
+        this->__done.store(0, std::memory_order_relaxed);
+        this->__open.store(True, std::memory_order_seq_cst);
+
+        this->__generation.fetch_add(1, std::memory_order_acq_rel);
+        this->__generation.notify_all();
+
+        this->__work(0);
+        __spin_until([this, count](){ return this->__done.load(std::memory_order_acquire) >= count; });
+
+        // Junção: ninguém mais pode ler `fn` depois que retornarmos
+        this->__open.store(False, std::memory_order_seq_cst);
+        __spin_until([this](){ return this->__active.load(std::memory_order_seq_cst) == 0; });
+    }
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <array>
+#include <cstdint>
+#include <iostream>
+
+// --- Bibliotecas de Sistema (Linux) ---
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <errno.h>
+
+/**
+ * @class Poller
+ * @brief Encapsulamento RAII mínimo sobre o `epoll` do Linux.
+ * @details
+ * Cada descritor registrado carrega um ponteiro opaco (`data`) que é devolvido
+ * quando o descritor fica pronto, permitindo ao chamador saber qual agente acordou
+ * sem nenhuma busca adicional.
+ * O vetor de eventos é fixo e alocado junto ao objeto: nenhuma alocação ocorre em `wait`.
+ */
+class Poller {
+public:
+    ///< Máximo de eventos entregues por chamada (22 agentes no pior caso de self-play).
+    static constexpr int MAX_EVENTS = 32;
+
+private:
+    /// Descritor da instância epoll
+    int __epoll_fd;
+    ///< Eventos entregues pelo último `wait`
+    std::array<epoll_event, MAX_EVENTS> __events;
+
+public:
+    /**
+     * @brief Cria a instância epoll.
+     */
+    Poller() {
+        this->__epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
+        if(this->__epoll_fd < 0){
+            std::cerr << "Erro fatal: epoll_create1 falhou." << std::endl;
+            exit(1);
+        }
+    }
+
+    /**
+     * @brief Libera o descritor epoll. Os descritores registrados não são fechados.
+     */
+    ~Poller() { if(this->__epoll_fd != -1){ close(this->__epoll_fd); } }
+
+    Poller(const Poller&) = delete;
+    void operator=(const Poller&) = delete;
+
+    /**
+     * @brief Registra um descritor para monitoramento.
+     * @param fd Descritor a ser monitorado.
+     * @param data Ponteiro devolvido em `data()` quando o descritor acordar.
+     * @param events Máscara epoll desejada (padrão: leitura disponível).
+     * @return True se registrado com sucesso.
+     */
+    bool
+    add(int fd, void* data, uint32_t events = EPOLLIN){
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.ptr = data;
+        return epoll_ctl(this->__epoll_fd, EPOLL_CTL_ADD, fd, &ev) == 0;
+    }
+
+    /**
+     * @brief Altera a máscara de eventos de um descritor já registrado.
+     * @param fd Descritor previamente registrado.
+     * @param data Ponteiro devolvido em `data()` quando o descritor acordar.
+     * @param events Nova máscara epoll (ex: EPOLLIN | EPOLLOUT enquanto houver bytes a enviar).
+     * @return True se alterado com sucesso.
+     */
+    bool
+    modify(int fd, void* data, uint32_t events){
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.ptr = data;
+        return epoll_ctl(this->__epoll_fd, EPOLL_CTL_MOD, fd, &ev) == 0;
+    }
+
+    /**
+     * @brief Remove um descritor do monitoramento.
+     * @param fd Descritor previamente registrado.
+     * @return True se removido com sucesso.
+     */
+    bool
+    remove(int fd){ return epoll_ctl(this->__epoll_fd, EPOLL_CTL_DEL, fd, nullptr) == 0; }
+
+    /**
+     * @brief Aguarda até que algum descritor fique pronto ou o tempo se esgote.
+     * @param timeout_ms Tempo máximo de espera em milissegundos (-1 espera indefinidamente).
+     * @return Quantidade de descritores prontos (0 em timeout ou interrupção por sinal).
+     */
+    int
+    wait(int timeout_ms){
+        int n = epoll_wait(this->__epoll_fd, this->__events.data(), MAX_EVENTS, timeout_ms);
+        // EINTR acontece, por exemplo, no SIGINT que encerra a aplicação
+        return (n < 0) ? 0 : n;
+    }
+
+    /**
+     * @brief Ponteiro opaco associado ao i-ésimo evento do último `wait`.
+     */
+    void*
+    data(int i) const { return this->__events[i].data.ptr; }
+
+    /**
+     * @brief Máscara de eventos do i-ésimo evento do último `wait`.
+     */
+    uint32_t
+    events(int i) const { return this->__events[i].events; }
+};
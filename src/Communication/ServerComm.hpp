@@ -2,6 +2,12 @@
 
 #include "../Booting/booting_templates.hpp"
 #include "../Environment/Environment.hpp"
+#include "FrameDecoder.hpp"
+#include "FrameRecorder.hpp"
+#include "CommStats.hpp"
+#include "CommandBuilder.hpp"
+#include "Poller.hpp"
+#include "UringTransport.hpp"
 
 // --- Bibliotecas da Standard Library ---
 #include <vector>
@@ -11,7 +17,8 @@
 #include <cstdint>
 #include <cstdio>
 #include <string_view>
-#include <format>
+#include <chrono>
+#include <memory>
 
 // --- Bibliotecas de Sistema (POSIX) ---
 #include <sys/socket.h>
@@ -30,60 +37,166 @@
  * @class ServerComm
  * @brief Gerencia a comunicação TCP de baixo nível com o servidor rcssserver3d.
  * @details Implementa estratégias de buffering, leitura não-bloqueante segura (polling)
- * e envio otimizado via writev.
+ * e envio otimizado via writev. Somente quando compilado com ENABLE_IO_URING (`make ... URING=1`,
+ * havendo liburing), o mesmo API passa a utilizar o UringTransport, caindo de volta para POSIX se o kernel recusar.
  */
 class ServerComm {
 private:
     /// Descritor de arquivo do socket
     int __sock_fd;
-    ///< Buffer persistente para leitura (evita realocações frequentes)
-    std::vector<char> __read_buffer;
+    ///< Anel de recebimento e enquadramento das mensagens (alocado uma única vez)
+    FrameDecoder __decoder;
     ///< Buffer persistente para acumular comandos antes do envio
     std::string __send_buffer;
+    ///< Buffer dos comandos de handshake (scene/init), enviados fora do ciclo
+    std::string __control_buffer;
     ///< Ponteiro para ambiente
     Environment* __env = nullptr;
+    ///< True se recebemos uma mensagem do servidor e ainda não respondemos a ela
+    bool __cycle_pending = False;
+    ///< Contadores e histogramas de recebimento (ver CommStats)
+    CommStats __stats;
+    ///< Instante em que o último frame interpretado chegou
+    std::chrono::steady_clock::time_point __arrival;
+    ///< time_server do último frame interpretado (negativo antes do primeiro)
+    float __last_time_server = -1.0f;
+    ///< Se True, `pump`/`receive` apenas guardam o frame; a interpretação fica para `parse_pending`
+    bool __deferred = False;
+    ///< Frame guardado no modo adiado (válido até a próxima leitura do socket)
+    std::string_view __pending;
+
+    ///< True enquanto o socket estiver registrado no epoll do time (ver `__team_poller`)
+    bool __in_team_poller = False;
+
+    /**
+     * @brief Epoll compartilhado por todos os agentes do processo durante o handshake.
+     * @details Cada agente se registra em `initialize_agent`, permitindo que `receive_async`
+     * durma até que algum socket do time tenha dados, em vez de fazer polling.
+     * Criado no primeiro uso (e não na inicialização estática): processos que não fazem o
+     * handshake por aqui, como os benchmarks, não abrem um epoll à toa.
+     */
+    static Poller& __team_poller() {
+        static Poller poller;
+        return poller;
+    }
+    ///< Tempo máximo de espera do keep-alive antes de reavaliar os parceiros
+    static constexpr int KEEP_ALIVE_TIMEOUT_MS = 20;
+    ///< Captura compartilhada pelos agentes do processo (nula quando a gravação está desligada)
+    inline static FrameRecorder* __recorder = nullptr;
 
 #ifdef ENABLE_DEBUG_VISION
     int __sock_fd_debug_vision;
     struct sockaddr_un __debug_vision_addr{};
 #endif
 
+#ifdef SSR_HAS_IO_URING
+    ///< Transporte io_uring, criado na inicialização (nulo se o kernel não o suportar)
+    std::unique_ptr<UringTransport> __uring;
+    bool __use_uring = False;
+#endif
+
     /**
-     * @brief Tenta ler exatamente N bytes do socket.
-     * @param buffer Ponteiro para o destino dos dados.
-     * @param len Quantidade de bytes a serem lidos.
-     * @return True se leu todos os bytes com sucesso.
-     * @return False se houve erro, timeout ou fechamento da conexão (EOF).
+     * @brief Entrega uma mensagem completa ao ambiente (e ao visualizador, se habilitado).
+     * @param msg Corpo da mensagem, já sem o cabeçalho de 4 bytes.
      */
-    bool __recv_all(
-        void* buffer,
-        size_t len
+    void __dispatch(
+        std::string_view msg
     ) {
-        size_t total_read = 0;
-        char* ptr = static_cast<char*>(buffer);
-
-        while(total_read < len){
-            ssize_t bytes = ::recv(
-                this->__sock_fd,
-                ptr + total_read,
-                len - total_read,
-                0
-            );
+        this->__env->update_from_server(
+            msg
+        );
 
-            if(bytes > 0){
-                total_read += bytes;
-            }
-            else if(bytes == 0){
-                return False; // EOF (Servidor fechou)
+#ifdef ENABLE_DEBUG_VISION
+        if(this->__sock_fd_debug_vision != -1){
+            if(
+                msg.find("(See") != std::string_view::npos
+            ){
+
+                sendto(
+                    this->__sock_fd_debug_vision,
+                    msg.data(),
+                    msg.size(),
+                    0,
+                    (struct sockaddr*)&this->__debug_vision_addr,
+                    sizeof(this->__debug_vision_addr)
+                );
             }
-            else {
-                if(errno == EINTR){ continue; }
-                // Timeout do socket (SO_RCVTIMEO) configurado no construtor
-                if(errno == EAGAIN || errno == EWOULDBLOCK){ return False; }
-                return False; // Erro fatal
+        }
+#endif
+    }
+
+    /**
+     * @brief Acrescenta ao anel os bytes vindos do io_uring, contabilizando-os.
+     */
+    void __append(const char* data, size_t len) {
+        this->__decoder.append(data, len);
+        this->__stats.bytes += len;
+    }
+
+    /**
+     * @brief Remove o socket encerrado do epoll do time.
+     * @details O epoll é level-triggered: um socket em EOF continuaria sempre pronto e
+     * faria o `receive_async` dos parceiros girar sem dormir.
+     */
+    void __leave_team_poller() {
+        if(!this->__in_team_poller){ return; }
+        ServerComm::__team_poller().remove(this->fd());
+        this->__in_team_poller = False;
+    }
+
+    /**
+     * @brief Entrega ao ambiente apenas o frame completo mais recente do anel.
+     * @details Frames anteriores são descartados sem cópia (estratégia de drenagem) e um frame
+     * parcial é preservado para a próxima leitura.
+     * @return Quantidade de frames completos encontrados.
+     */
+    int __deliver_latest() {
+        std::string_view msg;
+        int frames = 0;
+
+        if(ServerComm::__recorder != nullptr){
+            // Gravando: todo frame vai para a captura, mesmo os que a drenagem descartaria
+            std::string_view frame;
+            while(this->__decoder.next(frame)){
+                ServerComm::__recorder->record(this->__env->unum, frame);
+                msg = frame;
+                frames++;
             }
         }
-        return True;
+        else { frames = this->__decoder.latest(msg); }
+
+        // Frames que o anel cheio descartou antes de chegarem aqui também foram recebidos e perdidos
+        uint64_t discarded = this->__decoder.take_discarded();
+        this->__stats.frames += discarded;
+        this->__stats.dropped += discarded;
+        if(discarded > 0 && ServerComm::__recorder != nullptr){ ServerComm::__recorder->count_dropped(discarded); }
+
+        if(frames > 0){
+            this->__arrival = std::chrono::steady_clock::now();
+            this->__cycle_pending = True;
+
+            this->__stats.receives++;
+            this->__stats.frames += frames;
+            this->__stats.dropped += frames - 1;
+            this->__stats.drained.record(frames);
+
+            if(this->__deferred){ this->__pending = msg; }
+            else { this->__interpret(msg); }
+        }
+        return frames;
+    }
+
+    /**
+     * @brief Interpreta um frame e registra o salto de tempo do servidor.
+     */
+    void __interpret(std::string_view msg) {
+        this->__dispatch(msg);
+
+        float now = this->__env->time_server;
+        if(this->__last_time_server >= 0.0f && now > this->__last_time_server){
+            this->__stats.record_gap(uint64_t((now - this->__last_time_server) * 1e6f + 0.5f));
+        }
+        this->__last_time_server = now;
     }
 
 public:
@@ -102,7 +215,8 @@ public:
             shutdown(this->__sock_fd, SHUT_WR);
             int flags = fcntl(this->__sock_fd, F_GETFL, 0);
             fcntl(this->__sock_fd, F_SETFL, flags | O_NONBLOCK);
-            recv(this->__sock_fd, this->__read_buffer.data(), 4096, 0);
+            char discard[4096];
+            recv(this->__sock_fd, discard, sizeof(discard), 0);
             close(this->__sock_fd);
         }
 
@@ -111,14 +225,20 @@ public:
 #endif
     }
 
+    ///< Dono do socket (e do transporte): não pode ser copiado nem movido
+    ServerComm(const ServerComm&) = delete;
+    void operator=(const ServerComm&) = delete;
+
     /**
      * @brief Inicializa socket, buffers e configurações de rede.
      * @details Configura TCP_NODELAY para baixa latência e SO_RCVTIMEO para evitar deadlocks.
      */
     ServerComm() {
-        // Ajuste para 64KB (mensagens de visão podem ser grandes)
-        this->__read_buffer.resize(65536);
         this->__send_buffer.reserve(4096);
+        this->__control_buffer.reserve(128);
+
+        // Gravando: nenhum frame pode ser descartado antes de chegar à captura (o anel cresce)
+        if(ServerComm::__recorder != nullptr){ this->__decoder.keep_all(); }
 
         this->__sock_fd = socket(
             AF_INET,
@@ -175,6 +295,13 @@ public:
         ){
             usleep(500000); // 0.5s
         }
+
+#ifdef SSR_HAS_IO_URING
+        // Se o kernel recusar o io_uring (versão antiga, seccomp...), seguimos no caminho POSIX
+        this->__uring = std::make_unique<UringTransport>();
+        this->__use_uring = this->__uring->init(this->__sock_fd);
+        if(!this->__use_uring){ this->__uring.reset(); }
+#endif
     }
 
 
@@ -184,6 +311,12 @@ public:
      * @return True se houver bytes para ler, False caso contrário.
      */
     bool is_readable() {
+#ifdef SSR_HAS_IO_URING
+        if(this->__use_uring){
+            this->__uring->reap([this](const char* data, size_t len){ this->__append(data, len); });
+            return this->__decoder.has_frame();
+        }
+#endif
         fd_set readfds;
         FD_ZERO(&readfds);
         FD_SET(
@@ -212,6 +345,13 @@ public:
         std::string_view msg
     ) {
         if(msg.empty()){ return True; }
+        this->__cycle_pending = False;
+
+#ifdef SSR_HAS_IO_URING
+        if(this->__use_uring){
+            return this->__uring->send(msg, [this](const char* data, size_t len){ this->__append(data, len); });
+        }
+#endif
 
         uint32_t msg_len_host = static_cast<uint32_t>(msg.size());
         uint32_t msg_len_net = htonl(msg_len_host);
@@ -270,71 +410,144 @@ public:
      * e retorna apenas a mais recente para evitar lag acumulado.
      */
     void receive() {
-        uint32_t last_msg_size = 0;
+#ifdef SSR_HAS_IO_URING
+        if(this->__use_uring){
+            auto sink = [this](const char* data, size_t len){ this->__append(data, len); };
+            this->__uring->reap(sink);
+            // Mesma semântica do caminho POSIX: espera até 2s por um frame completo
+            while(!this->__decoder.has_frame() && !this->__uring->closed()){
+                if(!this->__uring->wait(2000, sink)){ break; }
+            }
+            this->__deliver_latest();
+            return;
+        }
+#endif
+        // Bloqueia (até o SO_RCVTIMEO) somente enquanto não houver um frame completo
+        while(!this->__decoder.has_frame()){
+            ssize_t bytes = this->__decoder.fill(this->__sock_fd);
+            if(bytes > 0){ this->__stats.bytes += bytes; continue; }
+            if(bytes < 0 && errno == EINTR){ continue; }
+            break; // Timeout, EOF ou erro
+        }
 
-        while(True) {
-            uint32_t net_len = 0;
+        // Estratégia de Drenagem: consome o que mais houver no Kernel sem bloquear
+        ssize_t bytes;
+        while((bytes = this->__decoder.fill(this->__sock_fd, MSG_DONTWAIT)) > 0){ this->__stats.bytes += bytes; }
 
-            // Tenta ler o cabeçalho (4 bytes)
-            if(
-                !this->__recv_all(
-                    &net_len,
-                    4
-                )
-            ){ break; }
+        this->__deliver_latest();
+    }
 
-            uint32_t msg_len = ntohl(net_len);
+    /**
+     * @brief Liga (ou desliga, com nullptr) a gravação dos frames recebidos por todos os agentes.
+     * @details Cada frame completo é acrescentado à captura com o instante de recebimento e o unum,
+     * antes de ser interpretado. A captura pode ser reproduzida com FrameReplayer (ver replay.cc).
+     * Chame antes de criar os comunicadores: assim seus anéis crescem em vez de descartar frames
+     * (o que ainda assim se perder é somado a FrameRecorder::dropped).
+     * @param recorder Captura já aberta, que deve sobreviver aos comunicadores.
+     */
+    static void record_to(FrameRecorder* recorder) { ServerComm::__recorder = recorder; }
 
-            // Tenta ler o corpo da mensagem
-            if(
-                !this->__recv_all(
-                    this->__read_buffer.data(),
-                    msg_len
-                )
-            ){ break; }
+    /**
+     * @brief Descritor a ser monitorado por um `Poller` para saber quando há dados.
+     */
+    int fd() const {
+#ifdef SSR_HAS_IO_URING
+        // No modo io_uring, quem sinaliza dados novos é o próprio anel
+        if(this->__use_uring){ return this->__uring->ring_fd(); }
+#endif
+        return this->__sock_fd;
+    }
 
-            last_msg_size = msg_len;
+    /**
+     * @brief Alterna o socket entre modo bloqueante e não-bloqueante.
+     * @details O handshake utiliza o modo bloqueante (com SO_RCVTIMEO). Laços orientados
+     * a eventos, como o TeamReactor, devem desligá-lo antes de usar `pump`.
+     * @param blocking True para bloqueante, False para não-bloqueante.
+     */
+    void set_blocking(bool blocking) {
+        int flags = fcntl(this->__sock_fd, F_GETFL, 0);
+        fcntl(
+            this->__sock_fd,
+            F_SETFL,
+            blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK)
+        );
+    }
 
-            // Estratégia de Drenagem: Se não há mais dados pendentes no Kernel,
-            // paramos aqui e retornamos o que temos.
-            if(!this->is_readable()){ break; }
+    /**
+     * @brief Consome os bytes disponíveis no Kernel sem jamais bloquear.
+     * @details Versão orientada a eventos de `receive`: lê tudo o que estiver disponível,
+     * mantém frames incompletos para a próxima chamada e, dentre os frames completos,
+     * entrega ao ambiente apenas o mais recente (mesma estratégia de drenagem).
+     * Todas as leituras usam MSG_DONTWAIT, independentemente do modo do socket.
+     * @return Quantidade de frames completos encontrados, ou -1 se a conexão foi encerrada.
+     */
+    int pump() {
+#ifdef SSR_HAS_IO_URING
+        if(this->__use_uring){
+            this->__uring->reap([this](const char* data, size_t len){ this->__append(data, len); });
+            int frames = this->__deliver_latest();
+            if(this->__uring->closed()){ this->__leave_team_poller(); return -1; }
+            return frames;
         }
+#endif
+        bool closed = False;
 
-        if(last_msg_size > 0){
-            this->__read_buffer[last_msg_size] = '\0'; // Null-terminate por segurança
-            std::string_view msg(
-                this->__read_buffer.data(),
-                last_msg_size
-            );
-            this->__env->update_from_server(
-                msg
-            );
+        while(True){
+            ssize_t bytes = this->__decoder.fill(this->__sock_fd, MSG_DONTWAIT);
 
-#ifdef ENABLE_DEBUG_VISION
-            if(this->__sock_fd_debug_vision != -1){
-                if(
-                    msg.find("(See") != std::string_view::npos
-                ){
-
-                    sendto(
-                        this->__sock_fd_debug_vision,
-                        msg.data(),
-                        msg.size(),
-                        0,
-                        (struct sockaddr*)&this->__debug_vision_addr,
-                        sizeof(this->__debug_vision_addr)
-                    );
-                }
-            }
-#endif
+            if(bytes > 0){ this->__stats.bytes += bytes; continue; }
+            if(bytes == 0){ closed = True; break; } // EOF (Servidor fechou)
+            if(errno == EINTR){ continue; }
+            if(errno != EAGAIN && errno != EWOULDBLOCK){ closed = True; }
+            break;
         }
-        return;
+
+        int frames = this->__deliver_latest();
+        if(closed){ this->__leave_team_poller(); return -1; }
+        return frames;
     }
 
+    /**
+     * @brief Adia a interpretação dos frames recebidos (modo em lote, ver TeamReactor::run_batch).
+     * @details Com o modo ligado, `pump` e `receive` apenas localizam o frame mais recente; ele é
+     * interpretado por `parse_pending`, que pode rodar em outra thread antes da próxima leitura deste socket.
+     */
+    void defer_parsing(bool deferred) { this->__deferred = deferred; }
+
+    /**
+     * @brief Interpreta o frame guardado no modo adiado, se houver.
+     * @details Toca apenas o Environment e as estatísticas deste agente: agentes diferentes podem
+     * ser interpretados concorrentemente.
+     * @return True se havia um frame pendente.
+     */
+    bool parse_pending() {
+        if(this->__pending.empty()){ return False; }
+        std::string_view msg = this->__pending;
+        this->__pending = {};
+        this->__interpret(msg);
+        return True;
+    }
+
+    /**
+     * @brief Indica se o agente recebeu uma mensagem à qual ainda não respondeu.
+     */
+    bool cycle_pending() const { return this->__cycle_pending; }
+
+    /**
+     * @brief Contadores e histogramas de recebimento deste agente.
+     */
+    const CommStats& stats() const { return this->__stats; }
+
+    /**
+     * @brief Resumo barato dos contadores (frames, descartes, latência chegada→send, saltos do servidor).
+     */
+    CommStats::Snapshot snapshot() const { return this->__stats.snapshot(); }
+
     /**
      * @brief Aguarda resposta do servidor mantendo os outros agentes vivos (Keep-Alive).
-     * @details Realiza polling neste socket. Se não houver dados, envia (syn) para os parceiros
-     * e drena a leitura deles para evitar buffer overflow.
+     * @details Dorme no epoll do time até que algum socket tenha dados. Se for o nosso,
+     * interpretamos e saímos. Se for de um parceiro, interpretamos sua mensagem e enviamos
+     * o (syn) apenas para ele, pois somente agentes com ciclo pendente seguram o servidor.
      * @param other_players Lista de ponteiros para os comunicadores dos outros jogadores.
      */
     void receive_async(
@@ -347,36 +560,40 @@ public:
         }
 
         while(True){
-            // 1. Se EU tenho dados, leio e saio imediatamente.
-            if(this->is_readable()){
-                this->receive();
-                break;
+            // Uma mensagem nossa pode já ter chegado enquanto atendíamos os parceiros
+            if(this->__decoder.has_frame()){
+                this->pump();
+                return;
             }
 
-            // 2. Mantenho os outros vivos enquanto espero
-            for(auto* p : other_players){
-                p->send_immediate("(syn)");
+            int ready = ServerComm::__team_poller().wait(KEEP_ALIVE_TIMEOUT_MS);
+            bool mine = False;
 
-                // Drena buffer dos outros SE houver dados
-                if(p->is_readable()) {
-                    p->receive();
-                }
+            for(int i = 0; i < ready; i++){
+                ServerComm* p = static_cast<ServerComm*>(ServerComm::__team_poller().data(i));
+                if(p == this){ mine = True; continue; }
+                p->pump();
             }
 
-            // Yield para a CPU (1ms) para evitar uso de 100% em busy wait
-            usleep(1000);
+            // Keep-Alive somente para quem está com o ciclo pendente
+            for(auto* p : other_players){
+                if(p->__cycle_pending){ p->send_immediate("(syn)"); }
+            }
+
+            // pump nunca bloqueia: um frame ainda incompleto nos faz voltar ao epoll
+            if(mine && this->pump() != 0){ return; }
         }
     }
 
     /**
-     * @brief Realiza o handshake inicial do agente (Scene, Init e Sincronização).
+     * @brief Associa o comunicador ao ambiente do agente, sem trocar mensagens com o servidor.
+     * @details Primeira etapa do handshake: prepara o visualizador (se habilitado), define o unum
+     * e registra o socket no epoll do time. Usada por `initialize_agent` e pelo TeamBootstrapper.
      * @param unum Número do uniforme do jogador.
-     * @param other_players Referência para lista de outros jogadores para sincronização.
      * @param env Ponteiro para Ambiente do Jogador
      */
-    void initialize_agent(
+    void attach(
         int unum,
-        std::vector<ServerComm*>& other_players,
         Environment* env
     ) {
 #ifdef ENABLE_DEBUG_VISION
@@ -397,26 +614,56 @@ public:
         this->__env = env;
         this->__env->unum = unum;
 
-        // Scene: Define o modelo do corpo do robô
-        this->send_immediate(
-            std::format(
-                "(scene rsg/agent/nao/nao_hetero.rsg {})",
-                (unum <= 1) ? 0 :
-                (unum <= 4) ? 1 :
-                (unum == 5) ? 2 :
-                (unum <= 8) ? 3 : 4
-            )
+        // A partir de agora, somos acordados pelo epoll do time durante o handshake dos outros
+        this->__in_team_poller = ServerComm::__team_poller().add(this->fd(), this);
+    }
+
+    /**
+     * @brief Envia o comando `scene`, que define o modelo do corpo do robô (sem aguardar resposta).
+     */
+    bool send_scene() {
+        int unum = this->__env->unum;
+        this->__control_buffer.clear();
+        CommandBuilder(this->__control_buffer).scene(
+            (unum <= 1) ? 0 :
+            (unum <= 4) ? 1 :
+            (unum == 5) ? 2 :
+            (unum <= 8) ? 3 : 4
         );
+        return this->send_immediate(this->__control_buffer);
+    }
+
+    /**
+     * @brief Envia o comando `init`, que define time e número (sem aguardar resposta).
+     * @param team_name Nome do time (permite dois times no mesmo processo em self-play).
+     */
+    bool send_init(std::string_view team_name = TEAM_NAME) {
+        this->__control_buffer.clear();
+        CommandBuilder(this->__control_buffer).init(this->__env->unum, team_name);
+        return this->send_immediate(this->__control_buffer);
+    }
+
+    /**
+     * @brief Realiza o handshake inicial do agente (Scene, Init e Sincronização).
+     * @details Versão sequencial: o agente só retorna após suas respostas chegarem.
+     * Para conectar o time inteiro em paralelo, veja TeamBootstrapper.
+     * @param unum Número do uniforme do jogador.
+     * @param other_players Referência para lista de outros jogadores para sincronização.
+     * @param env Ponteiro para Ambiente do Jogador
+     */
+    void initialize_agent(
+        int unum,
+        std::vector<ServerComm*>& other_players,
+        Environment* env
+    ) {
+        this->attach(unum, env);
+
+        // Scene: Define o modelo do corpo do robô
+        this->send_scene();
         this->receive_async(other_players);
 
         // Init: Define time e número
-        this->send_immediate(
-            std::format(
-                "(init (unum {}) (teamname {}))",
-                unum,
-                TEAM_NAME
-            )
-        );
+        this->send_init();
         this->receive_async(other_players);
 
         // Sync Loop: Garante que todos entrem no ciclo de simulação juntos
@@ -427,15 +674,21 @@ public:
                 p->send_immediate("(syn)");
             }
 
-            // Drena outros sem travar
+            // Drena outros sem travar (pump nunca bloqueia)
             for(auto* p : other_players) {
-                if(p->is_readable()){ p->receive(); }
+                p->pump();
             }
 
-            if(this->is_readable()){ this->receive(); }
+            this->pump();
         }
     }
 
+    /**
+     * @brief Construtor de comandos que escreve direto no buffer de envio (sem enviar ainda).
+     * @details Caminho sem alocações para efetores, beam e say. Ex: `commands().joint(Effector::HE1, 0.5f)`.
+     */
+    CommandBuilder commands() { return CommandBuilder(this->__send_buffer); }
+
     /**
      * @brief Adiciona uma mensagem ao buffer de envio (sem enviar ainda).
      * @param msg Comando parcial a ser agendado (ex: "(he1 10)").
@@ -456,8 +709,16 @@ public:
         this->__send_buffer += "(syn)";
 
         // Envia o pacote completo
+        bool pending = this->__cycle_pending;
         bool result = this->send_immediate(this->__send_buffer);
 
+        if(pending){
+            this->__stats.sends++;
+            this->__stats.arrival_to_send_ns.record(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->__arrival).count()
+            );
+        }
+
         // Limpa o buffer para o próximo ciclo, mantendo a capacidade reservada
         this->__send_buffer.clear();
 
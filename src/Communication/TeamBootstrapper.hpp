@@ -0,0 +1,171 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+#include "ServerComm.hpp"
+#include "Poller.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <vector>
+#include <string_view>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+/**
+ * @class TeamBootstrapper
+ * @brief Realiza o handshake de todos os agentes do processo em paralelo.
+ * @details
+ * Em `initialize_agent`, cada agente espera suas respostas de `scene` e `init` antes que o próximo
+ * sequer comece. Aqui, os `scene` de todos são enviados de uma vez e cada agente avança de etapa
+ * assim que sua própria resposta chega, tudo conduzido por um único epoll:
+ *
+ * 1. SCENE: enviado a todos imediatamente.
+ * 2. INIT: enviado a cada agente assim que sua resposta ao scene chega.
+ * 3. READY: resposta ao init recebida. A partir daí, toda nova mensagem é respondida com (syn)
+ *    para que o agente não segure o servidor enquanto os outros terminam.
+ *
+ * Um agente cuja conexão o servidor encerra sai do epoll (CLOSED); a espera termina assim que
+ * todos estiverem prontos ou encerrados, sem aguardar o prazo.
+ *
+ * Suporta 11 agentes ou 22 (self-play), cada um com seu próprio nome de time.
+ */
+class TeamBootstrapper {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    ///< Etapa do handshake de cada agente
+    enum class Stage : uint8_t { SCENE_SENT, INIT_SENT, READY, CLOSED };
+
+    /**
+     * @struct Member
+     * @brief Agente sob responsabilidade do bootstrapper.
+     */
+    struct Member {
+        ServerComm* scom;            ///< Comunicador já associado (ver ServerComm::attach)
+        std::string_view team_name;  ///< Nome do time enviado no init
+        Stage stage;                 ///< Etapa atual do handshake
+    };
+
+    Poller __poller;
+    std::vector<Member> __members;
+    double __time_to_ready_ms = 0.0;
+
+public:
+    /**
+     * @brief Reserva espaço para o time inteiro.
+     * @param capacity 11 agentes, ou 22 em self-play.
+     */
+    explicit TeamBootstrapper(size_t capacity = 11) { this->__members.reserve(capacity); }
+
+    /**
+     * @brief Inclui um agente no handshake paralelo.
+     * @details O vetor é reservado no construtor, então os endereços entregues ao epoll são estáveis
+     * enquanto a capacidade for respeitada.
+     * @param scom Comunicador já conectado e associado ao seu ambiente.
+     * @param team_name Nome do time deste agente.
+     */
+    void
+    add(ServerComm* scom, std::string_view team_name = TEAM_NAME){
+        if(this->__members.size() == this->__members.capacity()){
+            std::cerr << "Erro fatal: TeamBootstrapper acima da capacidade reservada." << std::endl;
+            exit(1);
+        }
+        this->__members.push_back({scom, team_name, Stage::SCENE_SENT});
+        this->__poller.add(scom->fd(), &this->__members.back());
+    }
+
+    /**
+     * @brief Executa o handshake de todos os agentes e os sincroniza no ciclo do servidor.
+     * @param timeout_ms Tempo máximo total para que todos fiquem prontos.
+     * @return True se todos os agentes concluíram o handshake dentro do prazo
+     * (False também se o servidor encerrar a conexão de algum deles).
+     */
+    bool
+    run(int timeout_ms = 10000){
+        Clock::time_point start = Clock::now();
+        Clock::time_point deadline = start + std::chrono::milliseconds(timeout_ms);
+        size_t ready = 0;
+        size_t closed = 0;
+
+        // 1. Todos os scenes de uma vez
+        for(Member& m : this->__members){ m.scom->send_scene(); }
+
+        // 2. Cada agente avança de etapa quando sua resposta chega
+        while(ready + closed < this->__members.size() && Clock::now() < deadline && ::is_running){
+            int events = this->__poller.wait(20);
+
+            for(int i = 0; i < events; i++){
+                Member* m = static_cast<Member*>(this->__poller.data(i));
+                int frames = m->scom->pump();
+                if(frames < 0){
+                    // Servidor encerrou a conexão: o agente não volta, e não esperamos mais por ele
+                    this->__poller.remove(m->scom->fd());
+                    if(m->stage == Stage::READY){ ready--; }
+                    m->stage = Stage::CLOSED;
+                    closed++;
+                    continue;
+                }
+                if(frames == 0){ continue; } // Frame ainda incompleto
+
+                switch(m->stage){
+                    case Stage::SCENE_SENT: {
+                        m->scom->send_init(m->team_name);
+                        m->stage = Stage::INIT_SENT;
+                        break;
+                    }
+
+                    case Stage::INIT_SENT: {
+                        m->stage = Stage::READY;
+                        ready++;
+                        break;
+                    }
+
+                    case Stage::READY:
+                    case Stage::CLOSED: {
+                        break;
+                    }
+                }
+            }
+
+            // Keep-Alive: quem já está pronto não pode segurar o ciclo dos demais
+            for(Member& m : this->__members){
+                if(m.stage == Stage::READY && m.scom->cycle_pending()){ m.scom->send_immediate("(syn)"); }
+            }
+        }
+
+        if(ready < this->__members.size()){
+            for(const Member& m : this->__members){
+                if(m.stage == Stage::CLOSED){
+                    std::cerr << "[TeamBootstrapper] Conexao encerrada pelo servidor durante o handshake" << std::endl;
+                }
+                else if(m.stage != Stage::READY){
+                    std::cerr << "[TeamBootstrapper] Agente sem resposta ao handshake (fd " << m.scom->fd() << ")" << std::endl;
+                }
+            }
+            return False;
+        }
+
+        // 3. Sync Loop: mesma sincronização final de ServerComm::initialize_agent, para o time todo
+        for(int i = 0; i < 3; ++i){
+            for(Member& m : this->__members){ m.scom->send_immediate("(syn)"); }
+            for(Member& m : this->__members){ m.scom->pump(); }
+        }
+
+        this->__time_to_ready_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        return True;
+    }
+
+    /**
+     * @brief Tempo, em milissegundos, entre o primeiro scene e o time inteiro pronto.
+     */
+    double
+    time_to_ready_ms() const { return this->__time_to_ready_ms; }
+
+    /**
+     * @brief Imprime o tempo total até o time ficar pronto.
+     */
+    void
+    print_report() const {
+        std::printf("[TeamBootstrapper] %zu agentes prontos em %.2f ms\n", this->__members.size(), this->__time_to_ready_ms);
+    }
+};
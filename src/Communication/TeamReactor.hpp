@@ -0,0 +1,216 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+#include "ServerComm.hpp"
+#include "Poller.hpp"
+#include "ParsePool.hpp"
+#include "CommStats.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @class TeamReactor
+ * @brief Laço de eventos single-thread que conduz os sockets de todos os agentes do time.
+ * @details
+ * Substitui o padrão "receive() de cada jogador em sequência": os sockets ficam em modo
+ * não-bloqueante e registrados em um único `epoll`. Assim que os bytes de um agente chegam,
+ * sua mensagem é interpretada, o agente "pensa" e seu `(syn)` é enviado imediatamente,
+ * sem esperar pelos outros dez. Um socket lento não atrasa mais ninguém.
+ *
+ * Para cada agente é registrada a latência entre o seu próprio `pump` (início da leitura dos seus
+ * bytes) e o término do seu `send`, em um Histogram: os agentes atendidos depois no mesmo despertar
+ * não são cobrados pelo tempo de pensar e enviar dos anteriores.
+ */
+class TeamReactor {
+public:
+    ///< Latência recebimento→envio de um agente (a mesma registrada pelo TeamScheduler).
+    using Latency = CycleLatency;
+
+    ///< Duração de um ciclo do servidor rcssserver3d (20 ms).
+    static constexpr uint64_t CYCLE_BUDGET_NS = CycleLatency::BUDGET_NS;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @struct Slot
+     * @brief Estado do reator associado a cada agente registrado.
+     */
+    struct Slot {
+        ServerComm* scom;         ///< Comunicador do agente
+        size_t index;             ///< Posição do agente no registro (devolvida ao callback)
+        bool alive;               ///< False após o servidor encerrar a conexão
+        Latency latency;          ///< Estatísticas do agente
+        Clock::time_point pumped; ///< Início do último `pump` (origem da latência)
+    };
+
+    Poller __poller;
+    ///< Reservado no registro; o endereço dos slots é estável durante o laço.
+    std::vector<Slot> __slots;
+    size_t __alive = 0;
+    ///< Agentes com frame pendente na rodada atual de `run_batch` (reservado no registro)
+    std::vector<Slot*> __batch;
+
+    /**
+     * @brief Registra a latência do `pump` do agente (`start`) até o fim do seu envio.
+     */
+    static void __record(Slot* slot, Clock::time_point start) {
+        slot->latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+
+    /**
+     * @brief Consome os bytes de um agente pronto; remove-o do epoll se a conexão terminou.
+     * @return Frames completos encontrados (0 se incompleto ou encerrado).
+     */
+    int __pump(Slot* slot) {
+        slot->pumped = Clock::now();
+        int frames = slot->scom->pump();
+        if(frames < 0){
+            // Servidor encerrou este agente: deixamos de monitorá-lo
+            this->__poller.remove(slot->scom->fd());
+            slot->alive = False;
+            this->__alive--;
+            return 0;
+        }
+        return frames;
+    }
+
+public:
+    /**
+     * @brief Prepara o reator para até `capacity` agentes.
+     * @param capacity Quantidade máxima de agentes (11, ou 22 em self-play).
+     */
+    explicit TeamReactor(size_t capacity = 11) {
+        this->__slots.reserve(capacity);
+        this->__batch.reserve(capacity);
+    }
+
+    /**
+     * @brief Registra o comunicador de um agente, já após o handshake.
+     * @details Coloca o socket em modo não-bloqueante. Deve ser chamado antes do primeiro
+     * `run_once`, pois o vetor de slots não pode realocar depois que o epoll guarda seus endereços.
+     * @param scom Comunicador do agente.
+     * @return Índice do agente dentro do reator.
+     */
+    size_t
+    add(ServerComm* scom){
+        if(this->__slots.size() == this->__slots.capacity()){
+            std::cerr << "Erro fatal: TeamReactor acima da capacidade reservada." << std::endl;
+            exit(1);
+        }
+
+        size_t index = this->__slots.size();
+        this->__slots.push_back({scom, index, True, {}, {}});
+
+        scom->set_blocking(False);
+        this->__poller.add(scom->fd(), &this->__slots.back());
+        this->__alive++;
+        return index;
+    }
+
+    /**
+     * @brief Quantidade de agentes cuja conexão ainda está ativa.
+     */
+    size_t
+    alive() const { return this->__alive; }
+
+    /**
+     * @brief Executa uma rodada do laço de eventos.
+     * @details Para cada socket pronto: consome os bytes (`pump`), e se um frame completo foi
+     * interpretado, chama `think(index)` e envia o ciclo com `send()` na sequência.
+     * @tparam Think Invocável com assinatura `void(size_t index)`, executado antes do envio.
+     * @param timeout_ms Tempo máximo de espera por eventos.
+     * @param think Lógica de decisão do agente que acabou de receber sua percepção.
+     * @return Quantidade de agentes que responderam nesta rodada.
+     */
+    template<typename Think>
+    int
+    run_once(int timeout_ms, Think&& think){
+        int ready = this->__poller.wait(timeout_ms);
+        int answered = 0;
+
+        for(int i = 0; i < ready; i++){
+            Slot* slot = static_cast<Slot*>(this->__poller.data(i));
+            if(this->__pump(slot) == 0){ continue; } // Frame ainda incompleto
+
+            think(slot->index);
+            slot->scom->send();
+
+            __record(slot, slot->pumped);
+            answered++;
+        }
+
+        return answered;
+    }
+
+    /**
+     * @brief Executa uma rodada do laço de eventos interpretando as percepções em paralelo.
+     * @details
+     * Modo em lote: os agentes prontos neste despertar apenas têm seus frames localizados
+     * (ServerComm::defer_parsing), o `pool` interpreta todos eles em paralelo e, após a junção,
+     * cada agente pensa e envia na sequência, como em `run_once`.
+     *
+     * Só compensa quando há vários agentes prontos a cada despertar e núcleos livres para o pool:
+     * com frames de poucos microssegundos, acordar e juntar as threads custa o mesmo que interpretar
+     * alguns frames (ver Communication/benchmark_parse_pool.cc para o ponto de equilíbrio nesta máquina).
+     * @tparam Think Invocável com assinatura `void(size_t index)`, executado após a junção.
+     * @param timeout_ms Tempo máximo de espera por eventos.
+     * @param pool Threads que interpretam os frames (com 0 threads, equivale a `run_once`).
+     * @param think Lógica de decisão de cada agente que recebeu sua percepção.
+     * @return Quantidade de agentes que responderam nesta rodada.
+     */
+    template<typename Think>
+    int
+    run_batch(int timeout_ms, ParsePool& pool, Think&& think){
+        int ready = this->__poller.wait(timeout_ms);
+
+        this->__batch.clear();
+        for(int i = 0; i < ready; i++){
+            Slot* slot = static_cast<Slot*>(this->__poller.data(i));
+            slot->scom->defer_parsing(True);
+            if(this->__pump(slot) > 0){ this->__batch.push_back(slot); }
+        }
+
+        Slot** batch = this->__batch.data();
+        pool.run(this->__batch.size(), [batch](size_t k){ batch[k]->scom->parse_pending(); });
+
+        for(Slot* slot : this->__batch){
+            think(slot->index);
+            slot->scom->send();
+            __record(slot, slot->pumped); // Inclui a espera pela junção do lote, que é o custo real deste modo
+        }
+
+        return int(this->__batch.size());
+    }
+
+    /**
+     * @brief Estatísticas de latência do agente de índice `index`.
+     */
+    const Latency&
+    latency(size_t index) const { return this->__slots[index].latency; }
+
+    /**
+     * @brief Imprime o relatório de latência recebimento→envio por agente.
+     */
+    void
+    print_report() const {
+        std::printf("\n=== TeamReactor: latencia recebimento -> envio (us) ===\n");
+        std::printf("%-6s %10s %10s %10s %10s %8s\n", "agente", "ciclos", "p50", "p99", "max", ">20ms");
+        for(const Slot& slot : this->__slots){
+            const Latency& lat = slot.latency;
+            std::printf(
+                "%-6zu %10llu %10.2f %10.2f %10.2f %8llu\n",
+                slot.index,
+                (unsigned long long)lat.ns.count(),
+                lat.ns.percentile(50) / 1e3,
+                lat.ns.percentile(99) / 1e3,
+                lat.ns.max() / 1e3,
+                (unsigned long long)lat.over_budget
+            );
+        }
+    }
+};
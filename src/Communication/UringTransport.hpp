@@ -0,0 +1,244 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+
+/*
+ * O transporte io_uring é opcional e fica desligado por padrão: só é compilado quando pedido
+ * explicitamente (`make ... URING=1`, que define ENABLE_IO_URING e liga a liburing).
+ * Caso contrário, ServerComm segue no caminho POSIX de sempre.
+ */
+#if defined(ENABLE_IO_URING) && __has_include(<liburing.h>)
+#define SSR_HAS_IO_URING 1
+
+// --- Bibliotecas da Standard Library ---
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string_view>
+
+// --- Bibliotecas de Sistema ---
+#include <liburing.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+/**
+ * @class UringTransport
+ * @brief Transporte de um socket do agente sobre io_uring.
+ * @details
+ * - Recebimento: um único `recv` multishot fica armado no kernel e deposita os bytes
+ *   em buffers registrados (provided buffer ring). Ler o que chegou é apenas consultar a
+ *   completion queue em memória compartilhada, sem syscall.
+ * - Envio: cabeçalho e corpo são submetidos como dois `send` encadeados (IOSQE_IO_LINK),
+ *   com uma única chamada `io_uring_enter` que submete e aguarda o término.
+ *
+ * Os bytes recebidos são entregues a um "sink" fornecido pelo chamador, responsável pelo
+ * enquadramento das mensagens (ver ServerComm).
+ */
+class UringTransport {
+private:
+    static constexpr unsigned QUEUE_DEPTH = 64;   ///< Entradas da submission queue
+    static constexpr unsigned BUF_COUNT   = 16;   ///< Buffers registrados (potência de 2)
+    static constexpr unsigned BUF_SIZE    = 16384;///< Tamanho de cada buffer registrado
+    static constexpr int      BUF_GROUP   = 0;    ///< Identificador do grupo de buffers
+
+    ///< Identificadores guardados em user_data de cada operação
+    enum : uint64_t { OP_RECV = 1, OP_SEND = 2 };
+
+    io_uring __ring{};
+    io_uring_buf_ring* __buf_ring = nullptr;
+    ///< Memória dos buffers registrados, alocada uma única vez
+    std::vector<char> __buf_pool;
+    int __sock_fd = -1;
+    bool __ready = False;
+    bool __closed = False;
+    ///< Cabeçalho do envio em andamento (precisa sobreviver até a conclusão)
+    uint32_t __header = 0;
+    unsigned __sends_in_flight = 0;
+    bool __send_failed = False;
+
+    /**
+     * @brief Arma (ou rearma) o recv multishot sobre o grupo de buffers registrados.
+     */
+    void __arm_recv() {
+        io_uring_sqe* sqe = io_uring_get_sqe(&this->__ring);
+        if(sqe == nullptr){
+            io_uring_submit(&this->__ring); // Fila cheia: submete o pendente para liberar entradas
+            sqe = io_uring_get_sqe(&this->__ring);
+            if(sqe == nullptr){ return; }
+        }
+        io_uring_prep_recv_multishot(sqe, this->__sock_fd, nullptr, 0, 0);
+        sqe->flags |= IOSQE_BUFFER_SELECT;
+        sqe->buf_group = BUF_GROUP;
+        io_uring_sqe_set_data64(sqe, OP_RECV);
+    }
+
+    /**
+     * @brief Devolve um buffer consumido ao anel de buffers registrados.
+     */
+    void __recycle(unsigned short bid) {
+        io_uring_buf_ring_add(
+            this->__buf_ring,
+            this->__buf_pool.data() + size_t(bid) * BUF_SIZE,
+            BUF_SIZE,
+            bid,
+            io_uring_buf_ring_mask(BUF_COUNT),
+            0
+        );
+        io_uring_buf_ring_advance(this->__buf_ring, 1);
+    }
+
+public:
+    UringTransport() = default;
+    UringTransport(const UringTransport&) = delete;
+    void operator=(const UringTransport&) = delete;
+
+    /**
+     * @brief Libera o anel e os buffers registrados.
+     */
+    ~UringTransport() {
+        if(!this->__ready){ return; }
+        io_uring_free_buf_ring(&this->__ring, this->__buf_ring, BUF_COUNT, BUF_GROUP);
+        io_uring_queue_exit(&this->__ring);
+    }
+
+    /**
+     * @brief Cria o anel, registra os buffers e arma o recebimento multishot.
+     * @param sock_fd Socket já conectado ao servidor.
+     * @return False se o kernel não oferecer os recursos necessários (o chamador deve usar POSIX).
+     */
+    bool init(int sock_fd) {
+        this->__sock_fd = sock_fd;
+
+        if(io_uring_queue_init(QUEUE_DEPTH, &this->__ring, 0) < 0){ return False; }
+
+        int ret = 0;
+        this->__buf_ring = io_uring_setup_buf_ring(&this->__ring, BUF_COUNT, BUF_GROUP, 0, &ret);
+        if(this->__buf_ring == nullptr){
+            io_uring_queue_exit(&this->__ring);
+            return False;
+        }
+
+        this->__buf_pool.resize(size_t(BUF_COUNT) * BUF_SIZE);
+        for(unsigned short bid = 0; bid < BUF_COUNT; bid++){ this->__recycle(bid); }
+
+        this->__arm_recv();
+        io_uring_submit(&this->__ring);
+
+        this->__ready = True;
+        return True;
+    }
+
+    /**
+     * @brief Descritor do anel: fica legível no epoll quando há completions pendentes.
+     */
+    int ring_fd() const { return this->__ring.ring_fd; }
+
+    /**
+     * @brief Indica se o servidor encerrou a conexão.
+     */
+    bool closed() const { return this->__closed; }
+
+    /**
+     * @brief Consome todas as completions disponíveis, sem syscall.
+     * @tparam Sink Invocável `void(const char* data, size_t len)` que recebe os bytes do socket.
+     * @return Quantidade de bytes entregues ao sink.
+     */
+    template<typename Sink>
+    size_t reap(Sink&& sink) {
+        size_t delivered = 0;
+        unsigned seen = 0;
+        bool rearm = False;
+        io_uring_cqe* cqe;
+        unsigned head;
+
+        io_uring_for_each_cqe(&this->__ring, head, cqe){
+            seen++;
+
+            if(io_uring_cqe_get_data64(cqe) == OP_SEND){
+                this->__sends_in_flight--;
+                if(cqe->res < 0){ this->__send_failed = True; }
+                continue;
+            }
+
+            // OP_RECV
+            if(cqe->flags & IORING_CQE_F_BUFFER){
+                unsigned short bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+                if(cqe->res > 0){
+                    sink(this->__buf_pool.data() + size_t(bid) * BUF_SIZE, size_t(cqe->res));
+                    delivered += cqe->res;
+                }
+                this->__recycle(bid);
+            }
+
+            if(cqe->res == 0){ this->__closed = True; } // EOF (Servidor fechou)
+            else if(cqe->res < 0 && cqe->res != -ENOBUFS){ this->__closed = True; }
+            else if(!(cqe->flags & IORING_CQE_F_MORE)){ rearm = True; } // Kernel desarmou o multishot
+        }
+
+        io_uring_cq_advance(&this->__ring, seen);
+
+        if(rearm && !this->__closed){
+            this->__arm_recv();
+            io_uring_submit(&this->__ring);
+        }
+        return delivered;
+    }
+
+    /**
+     * @brief Aguarda por novas completions até `timeout_ms` e as consome.
+     * @return True se alguma completion chegou antes do tempo limite.
+     */
+    template<typename Sink>
+    bool wait(int timeout_ms, Sink&& sink) {
+        io_uring_cqe* cqe;
+        __kernel_timespec ts = {timeout_ms / 1000, (timeout_ms % 1000) * 1000000LL};
+
+        if(io_uring_wait_cqe_timeout(&this->__ring, &cqe, &ts) != 0){ return False; }
+        this->reap(sink);
+        return True;
+    }
+
+    /**
+     * @brief Envia uma mensagem completa (cabeçalho + corpo) com dois sends encadeados.
+     * @details Submete e aguarda na mesma syscall. Retorna somente após a conclusão,
+     * de modo que o chamador pode reutilizar o buffer do corpo imediatamente.
+     * Bytes recebidos durante a espera são entregues normalmente ao sink.
+     * @return True se ambos os sends foram concluídos com sucesso.
+     */
+    template<typename Sink>
+    bool send(std::string_view msg, Sink&& sink) {
+        this->__header = htonl(static_cast<uint32_t>(msg.size()));
+        this->__send_failed = False;
+
+        // As duas entradas precisam estar disponíveis antes de preparar qualquer uma:
+        // um cabeçalho preparado sem o corpo seria submetido sozinho na próxima operação
+        if(io_uring_sq_space_left(&this->__ring) < 2){ io_uring_submit(&this->__ring); }
+        if(io_uring_sq_space_left(&this->__ring) < 2){ return False; }
+
+        io_uring_sqe* sqe_header = io_uring_get_sqe(&this->__ring);
+        io_uring_sqe* sqe_body   = io_uring_get_sqe(&this->__ring);
+
+        // MSG_WAITALL: o kernel insiste até enviar tudo, sem quebrar o encadeamento em escritas parciais
+        io_uring_prep_send(sqe_header, this->__sock_fd, &this->__header, 4, MSG_WAITALL | MSG_NOSIGNAL);
+        sqe_header->flags |= IOSQE_IO_LINK;
+        io_uring_sqe_set_data64(sqe_header, OP_SEND);
+
+        io_uring_prep_send(sqe_body, this->__sock_fd, msg.data(), msg.size(), MSG_WAITALL | MSG_NOSIGNAL);
+        io_uring_sqe_set_data64(sqe_body, OP_SEND);
+
+        this->__sends_in_flight += 2;
+        io_uring_submit_and_wait(&this->__ring, 1);
+        this->reap(sink);
+
+        while(this->__sends_in_flight > 0){
+            io_uring_cqe* cqe;
+            if(io_uring_wait_cqe(&this->__ring, &cqe) != 0){ return False; }
+            this->reap(sink);
+        }
+
+        return !this->__send_failed;
+    }
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include "ParsePool.hpp"
+#include "../Environment/Environment.hpp"
+#include "../Utils/MockServer/MockServer.hpp"
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+/**
+ * Ponto de equilíbrio entre interpretar as percepções de um ciclo em série e em paralelo (ParsePool).
+ *
+ * Uso: ./a.out [threads] [ciclos]
+ *   threads: maior quantidade de threads auxiliares testada (padrão: núcleos - 1, ao menos 1).
+ *
+ * Para cada tamanho de lote (agentes com frame no mesmo despertar) e cada quantidade de threads,
+ * mede a mediana do tempo de um lote: série (laço na thread atual) x pool (run + junção).
+ * Também mede o lote vazio do pool (acordar e juntar sem trabalho), o custo fixo do modo em lote.
+ * Os frames vêm do PerceptionGenerator, com visão a cada 3 ciclos como no servidor.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+static double
+median(std::vector<double>& samples){
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    return samples[samples.size() / 2];
+}
+
+int
+main(int argc, char** argv){
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    size_t max_threads = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : std::max(1u, cores - 1);
+    size_t cycles = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 600;
+    constexpr size_t AGENTS = 11;
+
+    // Frames de cada agente em cada ciclo
+    PerceptionGenerator generator(13);
+    std::vector<std::array<std::string, AGENTS>> frames(cycles);
+    for(size_t c = 0; c < cycles; c++){
+        float t = 0.02f * float(c);
+        for(size_t a = 0; a < AGENTS; a++){ frames[c][a] = generator.build(t, t, int(a + 1), "PlayOn", c % 3 == 0, 10, 2); }
+    }
+
+    std::vector<std::unique_ptr<Environment>> envs;
+    for(size_t a = 0; a < AGENTS; a++){ envs.push_back(std::make_unique<Environment>(Logger::get())); envs.back()->unum = uint8_t(a + 1); }
+
+    auto parse = [&envs](const std::array<std::string, AGENTS>& cycle, size_t a){
+        envs[a]->update_from_server(cycle[a]);
+        envs[a]->loc.visibles_landmarks.clear();
+    };
+
+    std::printf("nucleos: %u | ciclos: %zu | mediana por lote (us)\n", cores, cycles);
+    if(cores == 1){ std::printf("Aviso: um único núcleo; as threads do pool disputam o núcleo com a thread principal.\n"); }
+    std::printf("%-8s %9s", "threads", "vazio");
+    for(size_t n = 1; n <= AGENTS; n++){ char label[8]; std::snprintf(label, sizeof(label), "n=%zu", n); std::printf(" %9s", label); }
+    std::printf("  equilibrio\n");
+
+    std::vector<double> samples(cycles);
+
+    // Série: referência para todas as linhas
+    std::vector<double> serial(AGENTS + 1);
+    for(size_t n = 1; n <= AGENTS; n++){
+        for(size_t c = 0; c < cycles; c++){
+            Clock::time_point start = Clock::now();
+            for(size_t a = 0; a < n; a++){ parse(frames[c], a); }
+            samples[c] = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        }
+        serial[n] = median(samples);
+    }
+    std::printf("%-8s %9s", "serie", "-");
+    for(size_t n = 1; n <= AGENTS; n++){ std::printf(" %9.2f", serial[n]); }
+    std::printf("\n");
+
+    for(size_t threads = 1; threads <= max_threads; threads++){
+        ParsePool pool(threads);
+
+        for(size_t c = 0; c < cycles; c++){
+            Clock::time_point start = Clock::now();
+            pool.run(2, [](size_t){});
+            samples[c] = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        }
+        double empty = median(samples);
+
+        std::printf("%-8zu %9.2f", threads, empty);
+        size_t crossover = 0; ///< Menor lote a partir do qual o pool é sempre mais rápido
+        for(size_t n = 1; n <= AGENTS; n++){
+            for(size_t c = 0; c < cycles; c++){
+                const auto& cycle = frames[c];
+                Clock::time_point start = Clock::now();
+                pool.run(n, [&parse, &cycle](size_t a){ parse(cycle, a); });
+                samples[c] = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+            }
+            double batch = median(samples);
+            if(n >= 2 && batch < serial[n]){ if(!crossover){ crossover = n; } }
+            else { crossover = 0; }
+            std::printf(" %9.2f", batch);
+        }
+        if(crossover){ std::printf("  n >= %zu\n", crossover); }
+        else { std::printf("  nunca\n"); }
+    }
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file debug.cc
+ * @brief Verificação do enquadramento de mensagens (FrameDecoder) sem o servidor.
+ * @details Usa um socketpair local para simular o fluxo do rcssserver3d, cobrindo
+ * drenagem de vários frames, mensagens que cruzam o fim do anel, mensagens maiores que 64KB
+ * os percentis do histograma de CommStats e o formato dos comandos do CommandBuilder,
+ * além do terminador '\0' das views e da contagem de frames descartados com o anel cheio.
+ */
+
+#include "FrameDecoder.hpp"
+#include "CommStats.hpp"
+#include "CommandBuilder.hpp"
+#include "ParsePool.hpp"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstring>
+#include <cstdio>
+
+///< Escreve um frame no formato do servidor: [tamanho big-endian][corpo]
+void write_frame(int fd, const std::string& body) {
+    uint32_t net_len = htonl(static_cast<uint32_t>(body.size()));
+    std::string frame(reinterpret_cast<const char*>(&net_len), 4);
+    frame += body;
+    size_t sent = 0;
+    while(sent < frame.size()){ sent += ::send(fd, frame.data() + sent, frame.size() - sent, 0); }
+}
+
+void print_result(const std::string& title, bool passed) {
+    std::cout << "[" << (passed ? "\033[32mPASS\033[0m" : "\033[31mFAIL\033[0m") << "] " << title << std::endl;
+}
+
+int main() {
+    int fds[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+
+    // Anel pequeno de propósito para forçar voltas e crescimento
+    FrameDecoder decoder(64);
+    std::string_view msg;
+
+    // 1. Drenagem: três frames, apenas o último é entregue
+    write_frame(fds[1], "(time (now 1.00))");
+    write_frame(fds[1], "(time (now 1.02))");
+    write_frame(fds[1], "(time (now 1.04))");
+    while(decoder.fill(fds[0], MSG_DONTWAIT) > 0){}
+    int frames = decoder.latest(msg);
+    print_result("Drenagem entrega somente o frame mais recente", frames == 3 && msg == "(time (now 1.04))");
+
+    // 2. Frame parcial é preservado entre leituras
+    write_frame(fds[1], "(GS (t 0.00) (pm BeforeKickOff))");
+    decoder.fill(fds[0], MSG_DONTWAIT);
+    frames = decoder.latest(msg);
+    print_result("Frame completo apos leitura unica", frames == 1 && msg == "(GS (t 0.00) (pm BeforeKickOff))");
+
+    // 3. Frames que cruzam o fim do anel (capacidade 64)
+    bool wrap_ok = True;
+    for(int i = 0; i < 50; i++){
+        std::string body = "(HJ (n raj" + std::to_string(i) + ") (ax " + std::to_string(i * 0.5) + "))";
+        write_frame(fds[1], body);
+        while(!decoder.has_frame()){ decoder.fill(fds[0]); }
+        wrap_ok &= (decoder.latest(msg) == 1 && msg == body);
+    }
+    print_result("Frames que cruzam o fim do anel", wrap_ok);
+
+    // 4. Mensagem maior que 64KB (o antigo __read_buffer transbordava)
+    std::string big(200000, 'x');
+    big.front() = '(';
+    big.back() = ')';
+    // Escrita em outra thread: o buffer do socketpair pode ser menor que a mensagem
+    std::thread writer([&](){ write_frame(fds[1], big); write_frame(fds[1], "(time (now 2.00))"); });
+    size_t total = 0;
+    while(total < big.size() + 4 + 4 + 17){
+        ssize_t bytes = decoder.fill(fds[0]);
+        if(bytes <= 0){ break; }
+        total += bytes;
+    }
+    writer.join();
+    frames = decoder.latest(msg);
+    print_result("Mensagem de 200KB seguida de outra", frames == 2 && msg == "(time (now 2.00))");
+
+    writer = std::thread([&](){ write_frame(fds[1], big); });
+    while(!decoder.has_frame()){ decoder.fill(fds[0]); }
+    writer.join();
+    frames = decoder.latest(msg);
+    print_result("Mensagem de 200KB entregue integra", frames == 1 && msg == big);
+
+    // 5. Histograma dos contadores de comunicação: percentis com erro relativo de até ~6%
+    Histogram hist;
+    for(uint64_t v = 1; v <= 100000; v++){ hist.record(v); }
+    auto near = [](uint64_t got, double want){ return got >= want && got <= want * 1.07; };
+    print_result(
+        "Percentis do histograma log-linear",
+        near(hist.percentile(50), 50000) && near(hist.percentile(99), 99000) &&
+        hist.percentile(100) == 100000 && hist.min() == 1 && hist.count() == 100000
+    );
+
+    // 6. Comandos: mesmo texto que o snprintf("%.2f"), sem alocação por ciclo
+    bool fixed_ok = True;
+    for(int i = -200000; i <= 200000; i += 7){
+        float value = i / 997.0f;
+        char expected[32], got[32];
+        std::snprintf(expected, sizeof(expected), "%.2f", value);
+        *write_fixed(got, value) = '\0';
+        // snprintf escreve "-0.00" para negativos pequenos; o CommandBuilder, "0.00"
+        if(std::strcmp(expected, "-0.00") == 0){ std::strcpy(expected, "0.00"); }
+        fixed_ok &= (std::strcmp(expected, got) == 0);
+    }
+    std::string out;
+    out.reserve(4096);
+    const char* before = out.data();
+    std::array<float, EFFECTOR_COUNT> speeds{};
+    speeds[0] = 1.5f;
+    CommandBuilder(out).beam(-0.5f, 10.0f, 0.0f).joint(Effector::LLE6, -12.345f).joints(speeds).say("ab12").syn();
+    fixed_ok &= out.starts_with("(beam -0.50 10.00 0.00)(lle6 -12.35)(he1 1.50)(he2 0.00)(rae1 0.00)");
+    fixed_ok &= out.ends_with("(lle6 0.00)(say ab12)(syn)") && out.data() == before;
+    print_result("Comandos de efetores formatados sem realocacao", fixed_ok);
+
+    // 7. ParsePool: cada tarefa de cada lote executa exatamente uma vez, antes do retorno de run
+    bool pool_ok = True;
+    {
+        ParsePool pool(3);
+        std::array<std::atomic<uint32_t>, 22> runs{};
+        for(uint32_t batch = 1; batch <= 20000 && pool_ok; batch++){
+            size_t count = batch % 23;
+            pool.run(count, [&runs](size_t i){ runs[i].fetch_add(1, std::memory_order_relaxed); });
+            for(size_t i = 0; i < runs.size(); i++){
+                pool_ok &= runs[i].exchange(0, std::memory_order_relaxed) == (i < count ? 1u : 0u);
+            }
+        }
+    }
+    print_result("ParsePool executa cada tarefa do lote uma vez", pool_ok);
+
+    // 8. Views terminadas em '\0': no anel, no buffer auxiliar e com um frame parcial em seguida
+    std::vector<std::string> bodies;
+    std::string stream;
+    for(int i = 0; i < 60; i++){
+        bodies.push_back("(See (B (pol " + std::to_string(i * 1.25) + " 0 0)))");
+        uint32_t net_len = htonl(static_cast<uint32_t>(bodies.back().size()));
+        stream.append(reinterpret_cast<const char*>(&net_len), 4);
+        stream += bodies.back();
+    }
+    FrameDecoder nul_decoder(64);
+    size_t delivered = 0;
+    bool nul_ok = True;
+    for(size_t sent = 0; sent < stream.size(); ){
+        size_t chunk = std::min<size_t>(13, stream.size() - sent);
+        ::send(fds[1], stream.data() + sent, chunk, 0);
+        sent += chunk;
+        while(nul_decoder.fill(fds[0], MSG_DONTWAIT) > 0){}
+        int found = nul_decoder.latest(msg);
+        if(found == 0){ continue; }
+        delivered += found;
+        nul_ok &= (msg == bodies[delivered - 1] && msg.data()[msg.size()] == '\0');
+    }
+    print_result("Frames entregues terminados em '\\0'", nul_ok && delivered == bodies.size());
+
+    // 9. Anel cheio: a drenagem conta os frames descartados; no modo next nenhum se perde
+    FrameDecoder draining(8), lossless(8);
+    std::string_view frame;
+    lossless.next(frame); // Primeira chamada: o anel passa a crescer em vez de descartar
+    for(size_t sent = 0, chunk = 1; sent < stream.size(); sent += chunk, chunk = chunk % 7 + 1){
+        chunk = std::min(chunk, stream.size() - sent); // Pedaços de 1 a 7 bytes: cabeçalhos partidos ao meio
+        draining.append(stream.data() + sent, chunk);
+        lossless.append(stream.data() + sent, chunk);
+    }
+    frames = draining.latest(msg);
+    bool drop_ok = (uint64_t(frames) + draining.take_discarded() == bodies.size()) && msg == bodies.back();
+    drop_ok &= (draining.take_discarded() == 0);
+    size_t kept = 0;
+    while(lossless.next(frame)){ drop_ok &= (frame == bodies[kept++] && frame.data()[frame.size()] == '\0'); }
+    print_result("Descartes contados (latest) e nenhum frame perdido (next)", drop_ok && kept == bodies.size());
+
+    close(fds[0]);
+    close(fds[1]);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include "FrameRecorder.hpp"
+#include "../Environment/Environment.hpp"
+
+#include <vector>
+#include <chrono>
+#include <cstring>
+
+/**
+ * Reproduz uma captura do FrameRecorder diretamente no Environment de cada agente, sem o simulador.
+ *
+ * Uso: ./replay <captura> [--realtime]
+ *   Sem --realtime, os frames são entregues em velocidade máxima (benchmark do parser).
+ */
+int main(int argc, char** argv) {
+
+    if(argc < 2){
+        std::cerr << "Uso: " << argv[0] << " <captura> [--realtime]" << std::endl;
+        return 1;
+    }
+    bool realtime = (argc > 2 && std::strcmp(argv[2], "--realtime") == 0);
+
+    FrameReplayer replayer;
+    if(!replayer.open(argv[1])){
+        std::cerr << "Captura invalida: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    // Um ambiente por unum (até 22 agentes em self-play), como no processo original
+    std::vector<Environment> envs;
+    envs.reserve(23);
+    for(int unum = 0; unum < 23; unum++){
+        envs.emplace_back(Logger::get());
+        envs.back().unum = unum;
+    }
+
+    size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    size_t frames = replayer.replay(
+        [&envs, &bytes](int unum, std::string_view frame){
+            envs[(unum >= 0 && unum < 23) ? unum : 0].update_from_server(frame);
+            bytes += frame.size();
+        },
+        realtime
+    );
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf(
+        "%zu frames (%.2f MB) em %.3f s | %.1f ns/frame | %.1f MB/s\n",
+        frames, bytes / 1e6, seconds,
+        (frames == 0) ? 0.0 : seconds * 1e9 / double(frames),
+        (seconds == 0) ? 0.0 : bytes / 1e6 / seconds
+    );
+
+    return 0;
+}
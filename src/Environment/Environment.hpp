@@ -3,10 +3,22 @@
 #include "../Booting/booting_templates.hpp"
 #include "../Logger/Logger.hpp"
 #include "Tools/Localization/Localization.hpp"
+#include "StructuralIndex.hpp"
+#include "FastFloat.hpp"
+#include "ServerTags.hpp"
+#include "WorldSnapshot.hpp"
 #include <iostream>
 #include <string_view>
 #include <charconv> // std::from_chars
-#include <unordered_map>
+#include <type_traits>
+#include <memory>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h> // Envenenamento do buffer com sentinelas (ver update_from_server)
+#endif
 
 /**
  * @class Environment
@@ -34,7 +46,24 @@ public:
      */
     Environment(
         Logger& logger
-    ) : logger(logger) {}
+    ) : logger(logger), __published(std::make_unique<SeqlockSnapshot<WorldSnapshot>>()) {
+        this->__padded.resize(16384 + PADDING);
+    }
+
+    /**
+     * @brief Bytes de sentinela após cada mensagem interpretada (ver update_from_server).
+     * @details Um laço de sub-tags nunca avança mais que ~20 bytes além do fim antes de reavaliar o limite.
+     */
+    static constexpr ::size_t PADDING = 64;
+
+    /**
+     * @brief Padrão das sentinelas: '\0' encerra o salto de delimitadores e ')' encerra um token ou valor.
+     */
+    static constexpr std::array<char, PADDING> SENTINEL = [](){
+        std::array<char, PADDING> sentinel{};
+        for(::size_t i = 0; i < PADDING; i++){ sentinel[i] = (i % 2 == 0) ? '\0' : ')'; }
+        return sentinel;
+    }();
 
     /* -- Definição de Ferramentas que serão amplamente Usadas -- */
 
@@ -85,74 +114,68 @@ public:
     };
 
     /**
-     * @struct Enabler_Stringview_Hash
-     * @brief Functor de hash personalizado para permitir 'Heterogeneous Lookup'.
-     * @details Permite buscar chaves `std::string_view` em um mapa cujas chaves são `std::string`
-     * sem alocação temporária de memória.
-     */
-    struct Enabler_Stringview_Hash {
-        using is_transparent = void; ///< Sinaliza ao unordered_map que essa struct suporta tipos heterogêneos.
-
-        /**
-         * @brief Hash para chaves do tipo std::string.
-         */
-        ::size_t operator()(const std::string& s) const { return std::hash<std::string>{}(s); }
-
-        /**
-         * @brief Hash para chaves de busca do tipo std::string_view.
-         */
-        ::size_t operator()(std::string_view sv) const { return std::hash<std::string_view>{}(sv); }
-    };
-
-    /**
-     * @brief Tabela de conversão estática de strings do servidor para PlayMode.
+     * @brief Tabela de conversão estática dos modos de jogo do servidor para PlayMode.
      * @details
-     * A chave é a string recebida (ex: "KickOff_Left").
-     * O valor é um array com dois PlayModes: índice 0 para quando somos Left, índice 1 para quando somos Right.
-     * Utiliza `inline static` (C++17) para inicialização no header.
+     * Indexada pelo hash perfeito `PLAY_MODES` (ServerTags.hpp), na mesma ordem de `PLAY_MODE_NAMES`
+     * (ex: "KickOff_Left" é o índice 3). Cada entrada tem dois PlayModes: índice 0 para quando somos
+     * Left, índice 1 para quando somos Right (indexado por `!is_left`).
      */
-    inline static const std::unordered_map<
-        std::string,
-        std::array<PlayMode, 2>,
-        Enabler_Stringview_Hash,
-        std::equal_to<>
-    > play_modes = {
+    inline static constexpr std::array<std::array<PlayMode, 2>, PLAY_MODE_NAMES.size()> PLAY_MODE_TABLE = {{
         // --- Neutros (LEFT e RIGHT veem o mesmo modo) ---
-        {"BeforeKickOff", {Environment::PlayMode::BEFORE_KICKOFF, Environment::PlayMode::BEFORE_KICKOFF}},
-        {"GameOver",      {Environment::PlayMode::GAME_OVER,      Environment::PlayMode::GAME_OVER}},
-        {"PlayOn",        {Environment::PlayMode::PLAY_ON,        Environment::PlayMode::PLAY_ON}},
+        {PlayMode::BEFORE_KICKOFF, PlayMode::BEFORE_KICKOFF},  // BeforeKickOff
+        {PlayMode::GAME_OVER,      PlayMode::GAME_OVER},       // GameOver
+        {PlayMode::PLAY_ON,        PlayMode::PLAY_ON},         // PlayOn
 
         // --- LEFT Kick Events (LEFT é o nosso time, RIGHT é o time deles) ---
-        {"KickOff_Left",           {Environment::PlayMode::OUR_KICKOFF,      Environment::PlayMode::THEIR_KICKOFF}},
-        {"KickIn_Left",            {Environment::PlayMode::OUR_KICK_IN,      Environment::PlayMode::THEIR_KICK_IN}},
-        {"corner_kick_left",       {Environment::PlayMode::OUR_CORNER_KICK,  Environment::PlayMode::THEIR_CORNER_KICK}},
-        {"goal_kick_left",         {Environment::PlayMode::OUR_GOAL_KICK,    Environment::PlayMode::THEIR_GOAL_KICK}},
-        {"free_kick_left",         {Environment::PlayMode::OUR_FREE_KICK,    Environment::PlayMode::THEIR_FREE_KICK}},
-        {"pass_left",              {Environment::PlayMode::OUR_PASS,         Environment::PlayMode::THEIR_PASS}},
-        {"direct_free_kick_left",  {Environment::PlayMode::OUR_DIR_FREE_KICK, Environment::PlayMode::THEIR_DIR_FREE_KICK}},
-        {"Goal_Left",              {Environment::PlayMode::OUR_GOAL,         Environment::PlayMode::THEIR_GOAL}},
-        {"offside_left",           {Environment::PlayMode::OUR_OFFSIDE,      Environment::PlayMode::THEIR_OFFSIDE}},
+        {PlayMode::OUR_KICKOFF,       PlayMode::THEIR_KICKOFF},        // KickOff_Left
+        {PlayMode::OUR_KICK_IN,       PlayMode::THEIR_KICK_IN},        // KickIn_Left
+        {PlayMode::OUR_CORNER_KICK,   PlayMode::THEIR_CORNER_KICK},    // corner_kick_left
+        {PlayMode::OUR_GOAL_KICK,     PlayMode::THEIR_GOAL_KICK},      // goal_kick_left
+        {PlayMode::OUR_FREE_KICK,     PlayMode::THEIR_FREE_KICK},      // free_kick_left
+        {PlayMode::OUR_PASS,          PlayMode::THEIR_PASS},           // pass_left
+        {PlayMode::OUR_DIR_FREE_KICK, PlayMode::THEIR_DIR_FREE_KICK},  // direct_free_kick_left
+        {PlayMode::OUR_GOAL,          PlayMode::THEIR_GOAL},           // Goal_Left
+        {PlayMode::OUR_OFFSIDE,       PlayMode::THEIR_OFFSIDE},        // offside_left
+
         // --- RIGHT Kick Events (RIGHT é o nosso time, LEFT é o time deles) ---
-        {"KickOff_Right",          {Environment::PlayMode::THEIR_KICKOFF,    Environment::PlayMode::OUR_KICKOFF}},
-        {"KickIn_Right",           {Environment::PlayMode::THEIR_KICK_IN,    Environment::PlayMode::OUR_KICK_IN}},
-        {"corner_kick_right",      {Environment::PlayMode::THEIR_CORNER_KICK, Environment::PlayMode::OUR_CORNER_KICK}},
-        {"goal_kick_right",        {Environment::PlayMode::THEIR_GOAL_KICK,  Environment::PlayMode::OUR_GOAL_KICK}},
-        {"free_kick_right",        {Environment::PlayMode::THEIR_FREE_KICK,  Environment::PlayMode::OUR_FREE_KICK}},
-        {"pass_right",             {Environment::PlayMode::THEIR_PASS,       Environment::PlayMode::OUR_PASS}},
-        {"direct_free_kick_right", {Environment::PlayMode::THEIR_DIR_FREE_KICK, Environment::PlayMode::OUR_DIR_FREE_KICK}},
-        {"Goal_Right",             {Environment::PlayMode::THEIR_GOAL,       Environment::PlayMode::OUR_GOAL}},
-        {"offside_right",          {Environment::PlayMode::THEIR_OFFSIDE,    Environment::PlayMode::OUR_OFFSIDE}}
-    };
+        {PlayMode::THEIR_KICKOFF,       PlayMode::OUR_KICKOFF},        // KickOff_Right
+        {PlayMode::THEIR_KICK_IN,       PlayMode::OUR_KICK_IN},        // KickIn_Right
+        {PlayMode::THEIR_CORNER_KICK,   PlayMode::OUR_CORNER_KICK},    // corner_kick_right
+        {PlayMode::THEIR_GOAL_KICK,     PlayMode::OUR_GOAL_KICK},      // goal_kick_right
+        {PlayMode::THEIR_FREE_KICK,     PlayMode::OUR_FREE_KICK},      // free_kick_right
+        {PlayMode::THEIR_PASS,          PlayMode::OUR_PASS},           // pass_right
+        {PlayMode::THEIR_DIR_FREE_KICK, PlayMode::OUR_DIR_FREE_KICK},  // direct_free_kick_right
+        {PlayMode::THEIR_GOAL,          PlayMode::OUR_GOAL},           // Goal_Right
+        {PlayMode::THEIR_OFFSIDE,       PlayMode::OUR_OFFSIDE}         // offside_right
+    }};
+
+    /**
+     * @brief Índice estrutural da última mensagem recebida, reaproveitado entre mensagens.
+     */
+    StructuralIndex structural;
 
     /* Atributos Públicos de Ambiente */
 
-    float time_server;       ///< Instante de Tempo do Servidor, útil apenas para sincronização entre agentes.
+    float time_server = 0;   ///< Instante de Tempo do Servidor, útil apenas para sincronização entre agentes.
     float time_match;        ///< Instante de Tempo de Partida (Game Time).
     uint8_t goals_scored;    ///< Nossos Gols marcados.
     uint8_t goals_conceded;  ///< Gols adversários sofridos.
     uint8_t unum;            ///< Número do Jogador (Uniform Number).
     bool is_left;            ///< Indica se estamos jogando no lado esquerdo do campo (true) ou direito (false).
     PlayMode current_mode;   ///< Modo de jogo atual processado para nossa perspectiva.
+    std::string_view team_name = TEAM_NAME; ///< Nome do nosso time, para distinguir companheiros na visão.
+
+    /**
+     * @brief Blocos da percepção que este agente interpreta (ver TagMask).
+     * @details Os demais são pulados pelo índice estrutural. Ex: `MOTION_TAGS` para um teste de movimento,
+     * `NO_LINE_TAGS` para o goleiro. Os campos de blocos pulados mantêm o último valor lido.
+     */
+    TagMask interests = ALL_TAGS;
+
+    /**
+     * @brief Percepção do ciclo atual (juntas, IMU, pés, bola, jogadores e linhas).
+     */
+    WorldState world;
 
     /* Métodos Inerentes a Execução da Aplicação */
 
@@ -167,15 +190,27 @@ public:
      */
     class Parsing {
     private:
+        const char* begin  = nullptr; ///< Ponteiro para o início da string de mensagem.
         const char* buffer = nullptr; ///< Ponteiro atual na string de mensagem (cursor).
         const char* end    = nullptr; ///< Ponteiro para o final da string de mensagem.
         Environment* env   = nullptr; ///< Ponteiro para o ambiente onde os dados serão salvos.
+#ifndef DISABLE_STRUCTURAL_INDEX
+        const StructuralIndex& index; ///< Posições estruturais da mensagem, construídas uma única vez.
+
+        /**
+         * @brief Posição do cursor relativa ao início da mensagem.
+         */
+        ::size_t offset() const { return ::size_t(this->buffer - this->begin); }
+#endif
 
     public:
         /* Métodos Simples de Cursor */
 
         /**
          * @brief Construtor do Parsing dedicado à interpretação.
+         * @details Indexa as posições estruturais da mensagem inteira (ver StructuralIndex), de modo
+         * que o cursor salta entre elas em vez de andar byte a byte. Compilando com
+         * `-DDISABLE_STRUCTURAL_INDEX`, o cursor volta a percorrer a mensagem byte a byte.
          * @param message Mensagem bruta (view) enviada pelo servidor.
          * @param env Ponteiro para a classe Environment que será populada.
          */
@@ -183,10 +218,18 @@ public:
             std::string_view& message,
             Environment* env
         ) :
+            begin(message.data()),
             buffer(message.data()),
             end(message.data() + message.size()),
             env(env)
-        {}
+#ifndef DISABLE_STRUCTURAL_INDEX
+            , index(env->structural)
+#endif
+        {
+#ifndef DISABLE_STRUCTURAL_INDEX
+            env->structural.build(message);
+#endif
+        }
 
         /**
          * @brief Avança o cursor até encontrar um determinado caractere, pulando-o em seguida.
@@ -195,6 +238,14 @@ public:
          */
         bool
         skip_until_char(char caract){
+#ifndef DISABLE_STRUCTURAL_INDEX
+            if(caract == '('){
+                ::size_t pos = this->index.next_open(this->offset());
+                if(pos >= this->index.size()){ this->buffer = this->end; return False; }
+                this->buffer = this->begin + pos + 1;
+                return True;
+            }
+#endif
             while(*this->buffer != caract){
                 if(this->buffer >= this->end){ return False; }
                 this->buffer++;
@@ -210,14 +261,22 @@ public:
          */
         std::string_view
         get_str(){
+#ifndef DISABLE_STRUCTURAL_INDEX
+            ::size_t start = this->index.next_token(this->offset());
+            ::size_t stop = this->index.next_delimiter(start);
+            this->buffer = this->begin + stop + 1;
+            return std::string_view(this->begin + start, stop - start);
+#else
             while(*this->buffer == ' ' || *this->buffer == '(' || *this->buffer == ')'){ this->buffer++; }
             const char* value_start = this->buffer;
             while(*this->buffer != ' ' && *this->buffer != ')'){ this->buffer++; }
             return std::string_view(value_start, ::size_t(this->buffer++ - value_start));
+#endif
         }
 
         /**
          * @brief Converte a sequência de caracteres atual em um número (int ou float). Pulando o último caractere.
+         * @details Floats passam pelo `parse_server_float` (decimais curtos do servidor), com `std::from_chars` como reserva.
          * @tparam T Tipo do dado a ser extraído (int, float, uint8_t, etc).
          * @param[out] out Referência para a variável que receberá o valor.
          * @return True se a conversão foi bem-sucedida, False caso contrário.
@@ -226,7 +285,15 @@ public:
         bool
         get_value(T& out){
             const char* value_start = this->buffer;
+#ifndef DISABLE_STRUCTURAL_INDEX
+            if(value_start >= this->end){ this->buffer = this->end + 1; return False; } // Mensagem truncada
+            this->buffer = this->begin + this->index.next_delimiter(this->offset());
+#else
             while(*this->buffer != ' ' && *this->buffer != ')'){ this->buffer++; }
+#endif
+#ifndef DISABLE_FAST_FLOAT
+            if constexpr (std::is_same_v<T, float>){ return parse_server_float(value_start, this->buffer++, out); }
+#endif
             return std::from_chars(value_start, this->buffer++, out).ec == std::errc{};
         }
 
@@ -240,12 +307,15 @@ public:
 
         /**
          * @brief Obtém um trecho da string ao redor do cursor atual para debug.
-         * @details Usada somente em caso de erro, captura 30 chars antes e 30 depois.
+         * @details Usada somente em caso de erro, captura até 20 chars antes e 20 depois, sem sair da mensagem.
          * @return std::string contendo o contexto do buffer.
          */
         std::string
         get(){
-            return std::string(std::string_view(this->buffer - 20, 40)); ///< Vamos pegar alguns endereços antes e alguns depois.
+            const char* cursor = std::min(this->buffer, this->end);
+            const char* from = (cursor - this->begin > 20) ? cursor - 20 : this->begin;
+            const char* to = (this->end - cursor > 20) ? cursor + 20 : this->end;
+            return std::string(from, ::size_t(to - from));
         }
 
         /**
@@ -256,12 +326,33 @@ public:
         skip_unknown(){
             ///< Como já iniciamos após ter visto o '('.
             uint8_t counter = 1;
+#ifndef DISABLE_STRUCTURAL_INDEX
+            ::size_t pos = this->offset();
+            while(counter != 0){
+                pos = this->index.next_paren(pos);
+                if(pos >= this->index.size()){ break; }
+                counter += this->index.is_open(pos) ? 1 : - 1;
+                pos++;
+            }
+            this->buffer = this->begin + pos;
+#else
             while(
-                counter != 0
+                counter != 0 && this->buffer < this->end
             ){
                 counter += (*this->buffer == ')') * (- 1) + (*this->buffer == '(') * 1;
                 this->buffer++;
             }
+#endif
+        }
+
+        /**
+         * @brief Pula o restante da sub-tag atual, parando sobre o ')' que a fecha.
+         * @details Deixa o cursor como os casos de `See` o deixam ao terminar de interpretar uma sub-tag.
+         */
+        void
+        skip_subtag(){
+            this->skip_unknown();
+            if(this->buffer > this->begin && this->buffer <= this->end && this->buffer[-1] == ')'){ this->buffer--; }
         }
 
         /* -- Métodos de Parsing -- */
@@ -292,31 +383,39 @@ public:
         parse_gamestate(){
 
             std::string_view lower_tag;
-            while(True){
+            while(this->buffer < this->end){ ///< Frames truncados terminam aqui
                 lower_tag = this->get_str(); ///< Obteremos as subtags
 
-                switch(lower_tag[0]){
+                switch(GameStateTag(GAME_STATE_TAGS.find(lower_tag))){
+
+                    case GameStateTag::SCORE_LEFT: {
+                        this->get_value(this->env->goals_scored);
+                        break;
+                    }
 
-                    case 's': { ///< Poderá ser 'sl' (score left), 'sr' (score right)
-                        this->get_value( (lower_tag[1] == 'l') ? this->env->goals_scored : this->env->goals_conceded );
+                    case GameStateTag::SCORE_RIGHT: {
+                        this->get_value(this->env->goals_conceded);
                         break;
                     }
 
-                    case 'p': { ///< Há apenas 'pm' (playmode)
+                    case GameStateTag::PLAY_MODE: {
                         // É garantido que já tenhamos tido is_left
-                        lower_tag = this->get_str();
-                        auto it = play_modes.find(lower_tag);
-                        if( it != play_modes.end() ){ this->env->current_mode = it->second[this->env->is_left]; }
+                        int mode = PLAY_MODES.find(this->get_str());
+                        if(mode >= 0){ this->env->current_mode = PLAY_MODE_TABLE[mode][!this->env->is_left]; }
+                        break;
+                    }
+
+                    case GameStateTag::TIME: {
+                        this->get_value(this->env->time_match);
                         break;
                     }
 
-                    case 't': { ///< Há 't' e 'team'.
-                        if(lower_tag.size() == 1){ this->get_value(this->env->time_match); } // Então é 't'
-                        else if(lower_tag[1] == 'e'){ env->is_left = this->get_str()[0] == 'l'; } // Então é 'team'
+                    case GameStateTag::TEAM: {
+                        env->is_left = this->get_str()[0] == 'l';
                         break;
                     }
 
-                    case 'u': { ///< Há apenas o 'u' (unum)
+                    case GameStateTag::UNUM: {
                         this->get_value(this->env->unum);
                         break;
                     }
@@ -342,9 +441,7 @@ public:
             // Só há uma tag aqui. Logo, não é necessário loop e busca por tentativas.
             this->advance(14); // Colocamos 13, pois nunca se sabe se virá um '-' para nos atrapalhar.
 
-            // Devemos usar Eigen
-            float value;
-            for(int i = 0; i < 3; i++){ this->get_value(value); }
+            for(int i = 0; i < 3; i++){ this->get_value(this->env->world.gyro[i]); }
         }
 
         /**
@@ -356,8 +453,7 @@ public:
          parse_accelerometer(){
 
             this->advance(13);
-            float value;
-            for(int i = 3; i < 3; i++){ this->get_value(value); }
+            for(int i = 0; i < 3; i++){ this->get_value(this->env->world.acc[i]); }
          }
 
 
@@ -375,89 +471,101 @@ public:
          parse_vision(){
 
             std::string_view lower_tag;
-            while(True){
+            this->env->loc.begin_vision();
+            while(this->buffer < this->end){ ///< Frames truncados terminam aqui
 
                 lower_tag = this->get_str();
+                int see_tag = SEE_TAGS.find(lower_tag);
 
-                switch(lower_tag[0]){
+                switch(SeeTag(see_tag)){
 
-                    case 'P': ///< Estamos vendo um jogador. Há outras lowers tags a serem verificadas.
-                        while(True){
+                    case SeeTag::PLAYER: { ///< Estamos vendo um jogador. Há outras lowers tags a serem verificadas.
+                        if(!(this->env->interests & SEE_PLAYERS)){ this->skip_subtag(); break; }
+                        int player = this->env->world.add_player();
+                        while(this->buffer < this->end){ ///< Frames truncados terminam aqui
 
                             lower_tag = this->get_str();
+                            int player_tag = PLAYER_TAGS.find(lower_tag);
 
-                            switch(lower_tag[0]){
+                            switch(PlayerTag(player_tag)){
 
-                                case 't': { ///< Informação de 'team' do jogador visto
-                                    this->get_str();
+                                case PlayerTag::TEAM: { ///< Informação de 'team' do jogador visto
+                                    bool teammate = this->get_str() == this->env->team_name;
+                                    if(player >= 0){ this->env->world.player_teammate[player] = teammate; }
                                     break;
                                 }
 
-                                case 'i': { ///< Saberemos o unum do jogador visto
-                                    uint8_t value;
+                                case PlayerTag::ID: { ///< Saberemos o unum do jogador visto
+                                    uint8_t value = 0;
                                     this->get_value(value);
+                                    if(player >= 0){ this->env->world.player_id[player] = value; }
                                     break;
                                 }
 
                                 // Após essas, qualquer informação dada será da parte do corpo dele.
-                                case 'h': {
-
-                                }
-                                case 'r': {
-
-                                }
-                                case 'l': {
-                                    // Vamos apenas pular as informações
+                                case PlayerTag::HEAD:
+                                case PlayerTag::RIGHT_ARM:
+                                case PlayerTag::LEFT_ARM:
+                                case PlayerTag::RIGHT_FOOT:
+                                case PlayerTag::LEFT_FOOT: {
                                     this->advance(5);
-                                    float value;
-                                    for(int i = 0; i < 3; i++){ this->get_value(value); }
+                                    float value[3];
+                                    for(int i = 0; i < 3; i++){ this->get_value(value[i]); }
+                                    this->env->world.set_body_part(player, ::size_t(player_tag - int(PlayerTag::HEAD)), value);
                                     break;
                                 }
 
                                 default:
-                                    this->env->logger.warn("[{}] Flag Desconhecida dentro de 'See:P': {}. \t Buffer Neste momento: {}", this->env->unum, lower_tag, this->buffer);
+                                    this->env->logger.warn("[{}] Flag Desconhecida dentro de 'See:P': {}. \t Buffer Neste momento: {}", this->env->unum, lower_tag, this->get());
                                     break;
                             }
 
                             if(*this->buffer == ')'){ this->advance(1); if(*this->buffer == ')'){ break; } } ///< Se após encontrarmos um ')' houver outro ')', então chegamos ao final da lower_tag.
                         }
                         break;
-
-                    case 'B': { ///< Obviamente, a bola.
-
                     }
-                    // Landmarks
-                    case 'G': {
 
+                    case SeeTag::BALL: { ///< Obviamente, a bola.
+                        this->advance(5);
+                        float value[3];
+                        for(int i = 0; i < 3; i++){ this->get_value(value[i]); }
+                        this->env->world.set_ball(value);
+                        break;
                     }
-                    case 'F': {
-                        // Lower_tag já indica a tag do landmark
+
+                    // Landmarks: o índice da tag é o índice do landmark
+                    case SeeTag::F2L: case SeeTag::F1L: case SeeTag::F2R: case SeeTag::F1R:
+                    case SeeTag::G2L: case SeeTag::G1L: case SeeTag::G2R: case SeeTag::G1R: {
 
                         this->advance(5);
                         float value[3];
                         for(int i = 0; i < 3; i++){ this->get_value(value[i]); }
 
                         // De posse desses dados
-                        env->loc.update_visible_landmark(lower_tag, value);
+                        env->loc.update_visible_landmark(::size_t(see_tag), value);
 
                         break;
                     }
 
-                    case 'L': { ///< Linhas Vistas
+                    case SeeTag::LINE: { ///< Linhas Vistas
+                        if(!(this->env->interests & SEE_LINES)){ this->skip_subtag(); break; }
 
                         this->advance(5);
                         // Precisamos pegar ambos pontos da linha
-                        float value;
-                        for(int i = 0; i < 3; i++){ this->get_value(value); }
+                        float start[3], end[3];
+                        for(int i = 0; i < 3; i++){ this->get_value(start[i]); }
 
                         this->advance(6);
-                        for(int i = 0; i < 3; i++){ this->get_value(value); }
+                        for(int i = 0; i < 3; i++){ this->get_value(end[i]); }
+
+                        this->env->world.add_line(start, end);
+                        this->env->loc.update_visible_line(start, end);
 
                         break;
                     }
 
                     default:
-                        this->env->logger.warn("[{}] Flag Desconhecida dentro de 'See': {}. \t Buffer Neste momento: {}", this->env->unum, lower_tag, this->buffer);
+                        this->env->logger.warn("[{}] Flag Desconhecida dentro de 'See': {}. \t Buffer Neste momento: {}", this->env->unum, lower_tag, this->get());
                         break;
                 }
 
@@ -476,10 +584,11 @@ public:
 
             // Dado que será sempre o mesmo padrão. É possível:
             this->advance(3);
-            std::string_view nome_da_junta = this->get_str();
+            int joint = JOINTS.find(this->get_str());
             this->advance(5);
             float value;
             this->get_value(value);
+            if(joint >= 0){ this->env->world.joint_angle[joint] = value; }
          }
 
         /**
@@ -495,24 +604,48 @@ public:
 
             // Dado que será sempre o mesmo padrão, é possível:
             this->advance(3);
-            this->get_str();
+            int foot = (this->get_str()[0] == 'l') ? 0 : 1; ///< 'lf' ou 'rf'
+            WorldState& world = this->env->world;
+            world.foot_touching[foot] = True;
 
             this->advance(4);
             // Começamos a pegar o vetor
-            float value;
-            for(int i = 0; i < 3; i++){ this->get_value(value); }
+            for(int i = 0; i < 3; i++){ this->get_value(world.foot_contact[foot][i]); }
 
             this->advance(4);
-            for(int i = 0; i < 3; i++){ this->get_value(value); }
+            for(int i = 0; i < 3; i++){ this->get_value(world.foot_force[foot][i]); }
         }
 
         /**
          * @brief Interpreta a mensagem de Audição ('hear').
-         * @details Responsável por processar mensagens de áudio (do juiz ou outros jogadores).
+         * @details
+         * Exemplos: (hear RoboIME 12.30 self msg) e (hear RoboIME 12.30 -45.12 msg), com o nome do time;
+         * servidores antigos omitem o nome: (hear 12.30 self msg). Mensagens do nosso time que decodificam
+         * (ver decode_team_message) alimentam `world.team`; as demais são ignoradas.
          */
         void
         parse_hear(){
-            // sanha
+
+            std::string_view first = this->get_str();
+            float heard_at = 0;
+            bool teammate = True;
+            if(!parse_server_float(first.data(), first.data() + first.size(), heard_at)){ ///< Começa pelo nome do time
+                teammate = first == this->env->team_name;
+                this->get_value(heard_at);
+            }
+
+            std::string_view source = this->get_str();
+            bool self = source == "self";
+            float direction = 0;
+            if(!self){ parse_server_float(source.data(), source.data() + source.size(), direction); }
+
+            std::string_view said = this->get_str();
+            if(!teammate){ return; }
+
+            TeamMessage message;
+            TeamKnowledge& team = this->env->world.team;
+            if(decode_team_message(said, message)){ team.update(message, heard_at, direction, self); }
+            else { team.rejected++; }
         }
     };
 
@@ -520,7 +653,10 @@ public:
      * @brief Responsável pela atualização do ambiente.
      * @details
      * Recebe a string bruta do servidor, instancia o parser e despacha para os métodos específicos
-     * baseados nas tags de nível superior ('time', 'GS', 'See', etc).
+     * baseados nas tags de nível superior ('time', 'GS', 'See', etc). Tags fora de `interests` são puladas.
+     *
+     * Com `-DDISABLE_PADDED_COPY` (somente para medir o custo da cópia, ver `make benchmark_padding`), a mensagem
+     * é interpretada no próprio buffer do chamador, que deve ser seguido de PADDING bytes de SENTINEL.
      * @param msg Mensagem bruta (std::string_view) enviada pelo servidor.
      */
     void
@@ -528,56 +664,81 @@ public:
         std::string_view msg
     ){
 
-        Parsing cursor(msg, this);
+        // Cópia com sentinelas: laços byte a byte param no padding, e os laços de sub-tags checam o fim.
+        // Assim, nenhuma mensagem (truncada ou malformada) faz o parser ler fora do buffer.
+#ifdef DISABLE_PADDED_COPY
+        std::string_view padded = msg;
+#else
+#if defined(__SANITIZE_ADDRESS__)
+        ASAN_UNPOISON_MEMORY_REGION(this->__padded.data(), this->__padded.size());
+#endif
+        if(this->__padded.size() < msg.size() + PADDING){ this->__padded.resize(msg.size() + PADDING); } // Caminho raro
+        std::memcpy(this->__padded.data(), msg.data(), msg.size());
+        std::memcpy(this->__padded.data() + msg.size(), SENTINEL.data(), PADDING);
+#if defined(__SANITIZE_ADDRESS__)
+        // O resto do buffer guarda bytes de mensagens anteriores: sob ASan, ler além das sentinelas é acusado
+        ASAN_POISON_MEMORY_REGION(this->__padded.data() + msg.size() + PADDING, this->__padded.size() - msg.size() - PADDING);
+#endif
+        std::string_view padded(this->__padded.data(), msg.size());
+#endif
+
+        Parsing cursor(padded, this);
+        this->world.begin_cycle();
         std::string_view upper_tag;
         while(True){
 
             if(
                 !cursor.skip_until_char('(')
-            ){ this->print_status(); return; }
+            ){
+                this->world.end_cycle(this->time_server); this->__publish(); this->print_status(); return;
+            }
 
             upper_tag = cursor.get_str(); ///< Vamos extrair uma tag
-            switch(upper_tag[0]){
-                case 't': { ///< Há apenas 'time'
+            int tag = SERVER_TAGS.find(upper_tag);
+            if(tag >= 0 && !(this->interests & tag_bit(ServerTag(tag)))){ cursor.skip_unknown(); continue; } ///< Fora da máscara
+
+            switch(ServerTag(tag)){
+                case ServerTag::TIME: {
                     cursor.parse_time();
                     break;
                 }
 
-                case 'G': { ///< Pode ser 'GS' ou 'GYR'
-                    if(upper_tag[1] == 'S'){
-                        cursor.parse_gamestate();
-                    }
-                    else if(upper_tag[1] == 'Y'){
-                        cursor.parse_gyroscope();
-                    }
-                    else{
-                        ///< Tag Desconhecida
-                        this->logger.warn("[{}] Tag Superior Desconhecida: [{}]", this->unum, upper_tag);
-                    }
+                case ServerTag::GS: {
+                    cursor.parse_gamestate();
+                    break;
+                }
+
+                case ServerTag::GYR: {
+                    cursor.parse_gyroscope();
                     break;
                 }
 
-                case 'A': {
-                    if(upper_tag[1] == 'C'){ cursor.parse_accelerometer(); }
+                case ServerTag::ACC: {
+                    cursor.parse_accelerometer();
                     break;
                 }
 
-                case 'S': {
-                    if(upper_tag[1] == 'e'){ cursor.parse_vision(); }
-                    else{ this->logger.warn("[{}] Tag Superior Desconhecida: [{}] \t Buffer neste momento: [{}]", this->unum, upper_tag, cursor.get()); cursor.skip_unknown(); }
+                case ServerTag::SEE: {
+                    cursor.parse_vision();
+                    this->__new_vision = True; ///< A pose é atualizada depois, em localize()
                     break;
                 }
 
-                case 'H': {
+                case ServerTag::HJ: {
                     cursor.parse_hingejoint();
                     break;
                 }
 
-                case 'F': {
+                case ServerTag::FRP: {
                     cursor.parse_force_resistance();
                     break;
                 }
 
+                case ServerTag::HEAR: {
+                    cursor.parse_hear();
+                    break;
+                }
+
                 default: {
                     ///< Tag Superior Desconhecida
                     this->logger.warn("[{}] Tag Superior Desconhecida: [{}] \t Buffer neste momento: [{}]", this->unum, upper_tag, cursor.get());
@@ -588,8 +749,72 @@ public:
         }
     }
 
+    /**
+     * @brief Atualiza a pose (Localization::localize) se chegou uma visão desde a última chamada, e publica o estado.
+     * @details Fica fora de update_from_server, como primeira etapa do "pensar" do agente (BasePlayer::perceive):
+     * o solver custa mais que a própria interpretação, e assim não entra no tempo do parser nem no do ParsePool.
+     * Chamar uma vez por percepção; sem visão nova, não faz nada (a pose só envelhece a cada visão sem solução).
+     * @return True se havia uma visão nova.
+     */
+    bool
+    localize(){
+        if(!this->__new_vision){ return False; }
+        this->__new_vision = False;
+        this->loc.localize(this->is_left);
+        this->__publish();
+        return True;
+    }
+
+    /**
+     * @brief Cópia consistente da última percepção interpretada, segura a partir de qualquer thread.
+     * @details Não bloqueia `update_from_server` (ver SeqlockSnapshot): outras threads, como a
+     * decisão ou um quadro compartilhado do time, devem ler o Environment de um agente por aqui.
+     * @param[out] out Destino da cópia.
+     * @return Quantidade de percepções publicadas até a lida (0 se nenhuma).
+     */
+    uint64_t
+    read_snapshot(WorldSnapshot& out) const { return this->__published->read(out); }
+
 private:
 
+    /**
+     * @brief Visão interpretada ainda não levada à localização (ver localize).
+     */
+    bool __new_vision = False;
+
+    /**
+     * @brief Cópia da mensagem atual seguida de PADDING bytes de sentinela (alocada na construção).
+     */
+    std::vector<char> __padded;
+
+    /**
+     * @brief Publicação das percepções para leitores concorrentes.
+     * @details No heap para que o endereço lido pelas outras threads não mude se o Environment for movido.
+     */
+    std::unique_ptr<SeqlockSnapshot<WorldSnapshot>> __published;
+
+    /**
+     * @brief Publica o estado ao fim de uma percepção.
+     */
+    void
+    __publish(){
+        this->__published->publish_with([this](WorldSnapshot& snapshot){
+            snapshot.time_server = this->time_server;
+            snapshot.time_match = this->time_match;
+            snapshot.goals_scored = this->goals_scored;
+            snapshot.goals_conceded = this->goals_conceded;
+            snapshot.unum = this->unum;
+            snapshot.is_left = this->is_left;
+            snapshot.current_mode = static_cast<uint8_t>(this->current_mode);
+            snapshot.my_position = this->loc.my_position;
+            snapshot.my_orientation = this->loc.my_orientation;
+            snapshot.localization_confidence = this->loc.confidence;
+            snapshot.localization_error = this->loc.position_error;
+            snapshot.visions_since_fix = this->loc.visions_since_fix;
+            snapshot.world = this->world;
+        });
+    }
+
     /**
      * @brief Imprime o estado atual do ambiente no console (Debug).
      * @details Atualmente retorna imediatamente (desabilitado). Útil para verificar parsing.
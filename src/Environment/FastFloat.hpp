@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <cstdint>
+#include <charconv>
+
+/**
+ * @brief Converte um número no formato do rcssserver3d (ex: `-33.26`, `0.00`, `104.87`).
+ * @details
+ * O servidor só envia decimais curtos: sinal opcional, dígitos, ponto e poucas casas decimais.
+ * Nesse formato, os dígitos formam uma mantissa inteira `m` e a quantidade de casas `k` dá a escala.
+ * Se `m < 2^24` e `k <= 10`, tanto `m` quanto `10^k` são exatos em float, e uma única divisão
+ * IEEE já entrega o float corretamente arredondado: o mesmo resultado do `std::from_chars`
+ * (caminho rápido de Clinger). Qualquer outra coisa (expoente, muitos dígitos, nan, etc.) recai
+ * no `std::from_chars`.
+ * @param first Início do número.
+ * @param last Fim do número (exclusivo).
+ * @param[out] out Valor convertido.
+ * @return True se a conversão foi bem-sucedida.
+ */
+inline bool
+parse_server_float(const char* first, const char* last, float& out){
+    static constexpr float POW10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+    const char* p = first;
+    bool negative = (p < last && *p == '-');
+    p += negative;
+
+    uint32_t mantissa = 0;
+    int digits = 0;
+    while(p < last && uint8_t(*p - '0') < 10){ mantissa = mantissa * 10 + uint32_t(*p - '0'); p++; digits++; }
+
+    int decimals = 0;
+    if(p < last && *p == '.'){
+        p++;
+        while(p < last && uint8_t(*p - '0') < 10){ mantissa = mantissa * 10 + uint32_t(*p - '0'); p++; decimals++; }
+    }
+
+    // Caminho rápido: tudo consumido, ao menos um dígito, mantissa e escala exatas em float
+    if(p == last && digits + decimals > 0 && digits + decimals <= 7 && decimals <= 10){
+        float value = float(mantissa) / POW10[decimals];
+        out = negative ? -value : value;
+        return True;
+    }
+
+    return std::from_chars(first, last, out).ec == std::errc{};
+}
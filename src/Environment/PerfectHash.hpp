@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @class PerfectHash
+ * @brief Hash perfeito gerado em tempo de compilação para um conjunto fixo de chaves.
+ * @details
+ * O construtor (`consteval`) procura uma semente para a qual nenhuma chave colide na tabela
+ * de `SLOTS` posições. Cada busca é então um hash FNV-1a da chave, um único acesso à tabela
+ * e uma comparação para rejeitar chaves desconhecidas, devolvendo o índice denso da chave
+ * (a posição dela no array original), que serve diretamente como índice de arrays fixos.
+ *
+ * Uso:
+ * @code
+ * inline constexpr std::array<std::string_view, 3> NAMES = {"time", "GS", "See"};
+ * inline constexpr PerfectHash TAGS{NAMES};
+ * int tag = TAGS.find("GS"); // 1, ou -1 se desconhecida
+ * @endcode
+ *
+ * @tparam N Quantidade de chaves (até 255).
+ * @tparam SLOTS Tamanho da tabela (potência de 2). Com 4N posições, poucas sementes bastam.
+ */
+template<::size_t N, ::size_t SLOTS = std::bit_ceil(N * 4)>
+class PerfectHash {
+    static_assert(N > 0 && N < 256, "PerfectHash: de 1 a 255 chaves");
+    static_assert(std::has_single_bit(SLOTS) && SLOTS >= N, "PerfectHash: SLOTS deve ser potência de 2 e >= N");
+
+private:
+    std::array<std::string_view, N> __keys{};
+    std::array<uint8_t, SLOTS> __slots{};  ///< Índice da chave + 1 (0 = posição vazia)
+    uint32_t __seed = 0;
+
+    static constexpr uint32_t __hash(std::string_view key, uint32_t seed) {
+        uint32_t h = 2166136261u ^ seed;
+        for(char c : key){ h = (h ^ uint8_t(c)) * 16777619u; }
+        return h ^ (h >> 16);
+    }
+
+public:
+    /**
+     * @param keys Chaves distintas; o índice de cada uma é sua posição no array.
+     * @details Falha na compilação se não houver semente sem colisões (ex: chaves repetidas).
+     */
+    consteval explicit PerfectHash(const std::array<std::string_view, N>& keys) : __keys(keys) {
+        for(uint32_t seed = 1; seed < 100000; seed++){
+            std::array<uint8_t, SLOTS> slots{};
+            bool collision = False;
+            for(::size_t i = 0; i < N && !collision; i++){
+                uint8_t& slot = slots[__hash(keys[i], seed) & (SLOTS - 1)];
+                collision = (slot != 0);
+                slot = uint8_t(i + 1);
+            }
+            if(!collision){ this->__slots = slots; this->__seed = seed; return; }
+        }
+        throw "PerfectHash: nenhuma semente sem colisoes (chaves repetidas?)";
+    }
+
+    /**
+     * @brief Índice denso da chave, ou -1 se ela não pertence ao conjunto.
+     */
+    constexpr int find(std::string_view key) const {
+        uint8_t slot = this->__slots[__hash(key, this->__seed) & (SLOTS - 1)];
+        if(slot == 0 || this->__keys[slot - 1] != key){ return -1; }
+        return int(slot - 1);
+    }
+
+    /**
+     * @brief Chave de índice `index`.
+     */
+    constexpr std::string_view key(::size_t index) const { return this->__keys[index]; }
+
+    /**
+     * @brief Quantidade de chaves.
+     */
+    static constexpr ::size_t size() { return N; }
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "PerfectHash.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Tags das mensagens do servidor, cada conjunto com seu hash perfeito (ver PerfectHash).
+ * O índice devolvido por `find` é o valor do enum correspondente.
+ */
+
+/**
+ * @enum ServerTag
+ * @brief Tags de nível superior de uma percepção: `(time ...)`, `(GS ...)`, etc.
+ */
+enum class ServerTag : uint8_t { TIME, GS, GYR, ACC, SEE, HJ, FRP, HEAR, COUNT };
+
+inline constexpr std::array<std::string_view, size_t(ServerTag::COUNT)> SERVER_TAG_NAMES = {
+    "time", "GS", "GYR", "ACC", "See", "HJ", "FRP", "hear"
+};
+inline constexpr PerfectHash SERVER_TAGS{SERVER_TAG_NAMES};
+
+/**
+ * @enum GameStateTag
+ * @brief Subtags de `GS`.
+ */
+enum class GameStateTag : uint8_t { SCORE_LEFT, SCORE_RIGHT, PLAY_MODE, TIME, TEAM, UNUM, COUNT };
+
+inline constexpr std::array<std::string_view, size_t(GameStateTag::COUNT)> GAME_STATE_TAG_NAMES = {
+    "sl", "sr", "pm", "t", "team", "unum"
+};
+inline constexpr PerfectHash GAME_STATE_TAGS{GAME_STATE_TAG_NAMES};
+
+/**
+ * @enum SeeTag
+ * @brief Subtags de `See`.
+ * @details As 8 primeiras seguem a ordem de `Localization::list_landmark`: o índice da tag
+ * é também o índice do landmark.
+ */
+enum class SeeTag : uint8_t {
+    F2L, F1L, F2R, F1R, G2L, G1L, G2R, G1R,
+    BALL, PLAYER, LINE,
+    COUNT
+};
+
+///< Quantidade de landmarks (bandeiras e traves) vistos pelo agente
+inline constexpr size_t LANDMARK_COUNT = size_t(SeeTag::BALL);
+
+inline constexpr std::array<std::string_view, size_t(SeeTag::COUNT)> SEE_TAG_NAMES = {
+    "F2L", "F1L", "F2R", "F1R", "G2L", "G1L", "G2R", "G1R",
+    "B", "P", "L"
+};
+inline constexpr PerfectHash SEE_TAGS{SEE_TAG_NAMES};
+
+/**
+ * @enum PlayerTag
+ * @brief Subtags de um jogador visto (`See` → `P`).
+ */
+enum class PlayerTag : uint8_t { TEAM, ID, HEAD, RIGHT_ARM, LEFT_ARM, RIGHT_FOOT, LEFT_FOOT, COUNT };
+
+inline constexpr std::array<std::string_view, size_t(PlayerTag::COUNT)> PLAYER_TAG_NAMES = {
+    "team", "id", "head", "rlowerarm", "llowerarm", "rfoot", "lfoot"
+};
+inline constexpr PerfectHash PLAYER_TAGS{PLAYER_TAG_NAMES};
+
+/**
+ * @brief Nomes das 22 juntas do NAO em `HJ`.
+ * @details Mesma ordem de `Effector` (CommandBuilder.hpp): o índice da junta percebida é o
+ * índice do efetor que a move.
+ */
+inline constexpr size_t JOINT_COUNT = 22;
+
+inline constexpr std::array<std::string_view, JOINT_COUNT> JOINT_NAMES = {
+    "hj1", "hj2",
+    "raj1", "raj2", "raj3", "raj4",
+    "laj1", "laj2", "laj3", "laj4",
+    "rlj1", "rlj2", "rlj3", "rlj4", "rlj5", "rlj6",
+    "llj1", "llj2", "llj3", "llj4", "llj5", "llj6"
+};
+inline constexpr PerfectHash JOINTS{JOINT_NAMES};
+
+/**
+ * @brief Modos de jogo enviados pelo servidor em `GS` → `pm`.
+ * @details O índice de cada nome indexa `Environment::PLAY_MODE_TABLE`.
+ */
+inline constexpr std::array<std::string_view, 21> PLAY_MODE_NAMES = {
+    // Neutros
+    "BeforeKickOff", "GameOver", "PlayOn",
+    // Eventos do time da esquerda
+    "KickOff_Left", "KickIn_Left", "corner_kick_left", "goal_kick_left", "free_kick_left",
+    "pass_left", "direct_free_kick_left", "Goal_Left", "offside_left",
+    // Eventos do time da direita
+    "KickOff_Right", "KickIn_Right", "corner_kick_right", "goal_kick_right", "free_kick_right",
+    "pass_right", "direct_free_kick_right", "Goal_Right", "offside_right"
+};
+inline constexpr PerfectHash PLAY_MODES{PLAY_MODE_NAMES};
+
+/**
+ * @brief Conjunto de blocos da percepção que um consumidor deseja interpretar (ver Environment::interests).
+ * @details Um bit por ServerTag, mais dois bits para os blocos mais caros dentro de `See`.
+ * Blocos fora da máscara são pulados pelo índice estrutural, sem conversão de números, e mantêm o valor anterior.
+ */
+using TagMask = uint16_t;
+
+inline constexpr TagMask
+tag_bit(ServerTag tag){ return TagMask(1u << unsigned(tag)); }
+
+inline constexpr TagMask SEE_LINES   = TagMask(1u << unsigned(ServerTag::COUNT));       ///< `See` → `L`
+inline constexpr TagMask SEE_PLAYERS = TagMask(1u << (unsigned(ServerTag::COUNT) + 1)); ///< `See` → `P`
+
+inline constexpr TagMask ALL_TAGS = TagMask((1u << (unsigned(ServerTag::COUNT) + 2)) - 1);
+
+///< Somente o corpo: tempo, juntas, IMU e sensores dos pés (testes de movimento)
+inline constexpr TagMask MOTION_TAGS =
+    tag_bit(ServerTag::TIME) | tag_bit(ServerTag::GYR) | tag_bit(ServerTag::ACC) | tag_bit(ServerTag::HJ) | tag_bit(ServerTag::FRP);
+
+///< Tudo exceto as linhas vistas (ex: goleiro, que se localiza pelas traves)
+inline constexpr TagMask NO_LINE_TAGS = TagMask(ALL_TAGS & ~SEE_LINES);
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <algorithm>
+#include <bit>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @class StructuralIndex
+ * @brief Índice estrutural de uma mensagem do servidor (posições de '(', ')' e ' ').
+ * @details
+ * Em uma única passada vetorizada (no estilo do simdjson), a mensagem inteira é classificada
+ * em blocos de 64 bytes, produzindo um bitmap por caractere estrutural: bit `i` ligado se o
+ * byte `i` é aquele caractere. O cursor do parser deixa de andar byte a byte e passa a saltar
+ * entre posições estruturais com `tzcnt` sobre palavras de 64 bits.
+ *
+ * Implementações, escolhidas em tempo de compilação:
+ * - AVX2: 2 comparações de 32 bytes por bloco (`-mavx2` ou `-march=native`);
+ * - SSE2: 4 comparações de 16 bytes por bloco (padrão em x86-64);
+ * - Escalar: para as demais arquiteturas.
+ *
+ * Os bitmaps já saem combinados para cada consulta do cursor (uma leitura por palavra),
+ * e são reservados na construção e reaproveitados a cada mensagem.
+ */
+class StructuralIndex {
+private:
+    /**
+     * @struct Block
+     * @brief Bitmaps de um bloco de 64 bytes, já combinados para cada consulta do cursor.
+     */
+    struct Block {
+        uint64_t open;       ///< '('
+        uint64_t delimiter;  ///< ' ' ou ')' (fim de um valor)
+        uint64_t paren;      ///< '(' ou ')'
+        uint64_t token;      ///< Nenhum dos três (início de um token)
+    };
+
+    std::vector<Block> __blocks;  ///< Um bloco a cada 64 bytes da mensagem
+    size_t __size = 0;            ///< Tamanho da mensagem indexada
+
+    /**
+     * @brief Classifica um bloco de 64 bytes.
+     */
+    static void __classify(const char* p, Block& block) {
+        uint64_t open, close, space;
+#if defined(__AVX2__)
+        const __m256i open_v  = _mm256_set1_epi8('(');
+        const __m256i close_v = _mm256_set1_epi8(')');
+        const __m256i space_v = _mm256_set1_epi8(' ');
+        open = close = space = 0;
+        for(int k = 0; k < 2; k++){
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * k));
+            open  |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, open_v))))  << (32 * k);
+            close |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, close_v)))) << (32 * k);
+            space |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, space_v)))) << (32 * k);
+        }
+#elif defined(__SSE2__)
+        const __m128i open_v  = _mm_set1_epi8('(');
+        const __m128i close_v = _mm_set1_epi8(')');
+        const __m128i space_v = _mm_set1_epi8(' ');
+        open = close = space = 0;
+        for(int k = 0; k < 4; k++){
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k));
+            open  |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, open_v))))  << (16 * k);
+            close |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, close_v)))) << (16 * k);
+            space |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, space_v)))) << (16 * k);
+        }
+#else
+        open = close = space = 0;
+        for(int i = 0; i < 64; i++){
+            open  |= uint64_t(p[i] == '(') << i;
+            close |= uint64_t(p[i] == ')') << i;
+            space |= uint64_t(p[i] == ' ') << i;
+        }
+#endif
+        block.open = open;
+        block.delimiter = close | space;
+        block.paren = open | close;
+        block.token = ~(open | close | space);
+    }
+
+    /**
+     * @brief Primeira posição >= `pos` cujo bit está ligado na palavra produzida por `word(i)`.
+     * @return A posição encontrada, ou `size()` se não houver.
+     */
+    template<typename Word>
+    size_t __find(size_t pos, Word&& word) const {
+        if(pos >= this->__size){ return this->__size; }
+
+        size_t i = pos >> 6;
+        uint64_t bits = word(i) & (~uint64_t(0) << (pos & 63)); // Ignora os bits anteriores a `pos`
+        size_t words = this->__blocks.size();
+
+        while(bits == 0){
+            if(++i >= words){ return this->__size; }
+            bits = word(i);
+        }
+        return std::min((i << 6) + size_t(std::countr_zero(bits)), this->__size);
+    }
+
+public:
+    ///< Implementação selecionada na compilação (para relatórios de benchmark).
+#if defined(__AVX2__)
+    static constexpr const char* BACKEND = "AVX2";
+#elif defined(__SSE2__)
+    static constexpr const char* BACKEND = "SSE2";
+#else
+    static constexpr const char* BACKEND = "escalar";
+#endif
+
+    /**
+     * @param capacity Tamanho de mensagem previsto (os bitmaps crescem se necessário).
+     */
+    explicit StructuralIndex(size_t capacity = 16384) { this->__blocks.reserve((capacity + 63) / 64); }
+
+    /**
+     * @brief Indexa uma mensagem inteira.
+     * @param msg Mensagem do servidor.
+     */
+    void build(std::string_view msg) {
+        this->__size = msg.size();
+        this->__blocks.resize((msg.size() + 63) / 64);
+
+        const char* p = msg.data();
+        size_t full = msg.size() / 64;
+        for(size_t i = 0; i < full; i++){ __classify(p + 64 * i, this->__blocks[i]); }
+
+        // Bloco final incompleto: completado com zeros, que não são estruturais
+        size_t rest = msg.size() - full * 64;
+        if(rest > 0){
+            alignas(64) char tail[64] = {};
+            std::memcpy(tail, p + full * 64, rest);
+            __classify(tail, this->__blocks[full]);
+        }
+    }
+
+    /**
+     * @brief Tamanho da mensagem indexada.
+     */
+    size_t size() const { return this->__size; }
+
+    /**
+     * @brief Verdadeiro se a posição `pos` é um '('.
+     */
+    bool is_open(size_t pos) const { return (this->__blocks[pos >> 6].open >> (pos & 63)) & 1; }
+
+    /**
+     * @brief Próximo '(' a partir de `pos` (inclusive), ou `size()`.
+     */
+    size_t next_open(size_t pos) const {
+        return this->__find(pos, [this](size_t i){ return this->__blocks[i].open; });
+    }
+
+    /**
+     * @brief Próximo delimitador de valor (' ' ou ')') a partir de `pos`, ou `size()`.
+     */
+    size_t next_delimiter(size_t pos) const {
+        return this->__find(pos, [this](size_t i){ return this->__blocks[i].delimiter; });
+    }
+
+    /**
+     * @brief Próximo parêntese ('(' ou ')') a partir de `pos`, ou `size()`.
+     */
+    size_t next_paren(size_t pos) const {
+        return this->__find(pos, [this](size_t i){ return this->__blocks[i].paren; });
+    }
+
+    /**
+     * @brief Próximo byte que não é estrutural (início de um token) a partir de `pos`, ou `size()`.
+     */
+    size_t next_token(size_t pos) const {
+        return this->__find(pos, [this](size_t i){ return this->__blocks[i].token; });
+    }
+};
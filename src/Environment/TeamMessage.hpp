@@ -0,0 +1,227 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Comunicação entre companheiros pelo `say`/`hear` do servidor.
+ *
+ * O servidor entrega até 20 caracteres ASCII imprimíveis, exceto espaço e parênteses: 92 símbolos.
+ * Uma mensagem do time cabe em 64 bits, escritos em base 92 com 10 caracteres (92^10 > 2^64):
+ *
+ *   bits  0..3   unum de quem fala (1 a 11)
+ *   bits  4..7   intenção (TeamIntent)
+ *   bit   8      bola vista pelo emissor
+ *   bits  9..20  bola x      (12 bits, [-16, 16] m, ~8 mm)
+ *   bits 21..32  bola y      (12 bits, [-11, 11] m, ~5 mm)
+ *   bits 33..44  emissor x
+ *   bits 45..56  emissor y
+ *   bits 57..63  verificação (7 bits de um hash dos 57 anteriores)
+ *
+ * A verificação descarta mensagens adversárias e ruído com probabilidade 127/128 antes mesmo
+ * dos testes de faixa. Codificar e decodificar não alocam: apenas aritmética inteira e tabelas constexpr.
+ */
+
+/**
+ * @enum TeamIntent
+ * @brief O que o emissor pretende fazer nos próximos ciclos.
+ */
+enum class TeamIntent : uint8_t { NONE, GO_TO_BALL, DRIBBLE, PASS, SHOOT, DEFEND, SUPPORT, COUNT };
+
+/**
+ * @struct TeamMessage
+ * @brief Conteúdo de uma mensagem entre companheiros, já em coordenadas do campo (m).
+ */
+struct TeamMessage {
+    uint8_t unum = 0;
+    TeamIntent intent = TeamIntent::NONE;
+    bool ball_seen = False;
+    std::array<float, 2> ball{};      ///< Posição estimada da bola
+    std::array<float, 2> position{};  ///< Posição estimada do emissor
+};
+
+///< Caracteres de uma mensagem codificada (dentro do limite de 20 do servidor)
+inline constexpr size_t TEAM_MESSAGE_SIZE = 10;
+
+/**
+ * @brief Símbolos aceitos pelo servidor, na ordem dos dígitos da base 92.
+ */
+inline constexpr std::array<char, 92> TEAM_MESSAGE_ALPHABET = [](){
+    std::array<char, 92> alphabet{};
+    size_t n = 0;
+    for(int c = 0x21; c <= 0x7E; c++){ if(c != '(' && c != ')'){ alphabet[n++] = char(c); } }
+    return alphabet;
+}();
+
+/**
+ * @brief Dígito de cada byte (-1 se o byte não pertence ao alfabeto).
+ */
+inline constexpr std::array<int8_t, 256> TEAM_MESSAGE_DIGIT = [](){
+    std::array<int8_t, 256> digit{};
+    digit.fill(-1);
+    for(size_t i = 0; i < TEAM_MESSAGE_ALPHABET.size(); i++){ digit[uint8_t(TEAM_MESSAGE_ALPHABET[i])] = int8_t(i); }
+    return digit;
+}();
+
+/**
+ * @brief Detalhes do formato: faixas, quantização e verificação.
+ */
+namespace TeamMessageCodec {
+
+    inline constexpr float FIELD_X = 16.0f;  ///< Meio comprimento do campo, com margem
+    inline constexpr float FIELD_Y = 11.0f;  ///< Meia largura do campo, com margem
+    inline constexpr uint32_t LEVELS = (1u << 12) - 1;
+
+    ///< [-range, range] → [0, 4095], saturando fora da faixa
+    inline uint64_t quantize(float value, float range) {
+        float unit = (value + range) * (float(LEVELS) / (2.0f * range));
+        if(!(unit > 0.0f)){ return 0; } // Também trata NaN
+        if(unit >= float(LEVELS)){ return LEVELS; }
+        return uint64_t(unit + 0.5f);
+    }
+
+    inline float dequantize(uint64_t level, float range) {
+        return float(level) * (2.0f * range / float(LEVELS)) - range;
+    }
+
+    ///< 7 bits de verificação dos 57 bits de conteúdo
+    inline constexpr uint64_t check(uint64_t payload) { return (payload * 0x9E3779B97F4A7C15ull) >> 57; }
+
+    inline constexpr uint64_t PAYLOAD_MASK = (1ull << 57) - 1;
+}
+
+/**
+ * @struct TeamMessageText
+ * @brief Mensagem codificada, pronta para `CommandBuilder::say`.
+ */
+struct TeamMessageText {
+    std::array<char, TEAM_MESSAGE_SIZE> chars{};
+    std::string_view view() const { return std::string_view(this->chars.data(), this->chars.size()); }
+};
+
+/**
+ * @brief Codifica uma mensagem do time (ver o formato no início do arquivo).
+ * @details Posições fora do campo são saturadas nas bordas.
+ */
+inline TeamMessageText
+encode_team_message(const TeamMessage& message){
+    using namespace TeamMessageCodec;
+
+    uint64_t payload = uint64_t(message.unum & 0xF)
+                     | uint64_t(uint8_t(message.intent) & 0xF) << 4
+                     | uint64_t(message.ball_seen) << 8
+                     | quantize(message.ball[0], FIELD_X) << 9
+                     | quantize(message.ball[1], FIELD_Y) << 21
+                     | quantize(message.position[0], FIELD_X) << 33
+                     | quantize(message.position[1], FIELD_Y) << 45;
+    uint64_t word = payload | check(payload) << 57;
+
+    TeamMessageText text;
+    for(size_t i = TEAM_MESSAGE_SIZE; i-- > 0;){
+        text.chars[i] = TEAM_MESSAGE_ALPHABET[word % 92];
+        word /= 92;
+    }
+    return text;
+}
+
+/**
+ * @brief Decodifica uma mensagem ouvida.
+ * @param said Texto da mensagem, como recebido em `hear`.
+ * @param[out] out Mensagem decodificada (alterada somente em caso de sucesso).
+ * @return False se o texto não é uma mensagem do time: tamanho, símbolos, verificação ou faixas inválidos.
+ */
+inline bool
+decode_team_message(std::string_view said, TeamMessage& out){
+    using namespace TeamMessageCodec;
+
+    if(said.size() != TEAM_MESSAGE_SIZE){ return False; }
+
+    uint64_t word = 0;
+    for(char c : said){
+        int digit = TEAM_MESSAGE_DIGIT[uint8_t(c)];
+        if(digit < 0){ return False; }
+        if(word > (UINT64_MAX - uint64_t(digit)) / 92){ return False; } // Além de 64 bits
+        word = word * 92 + uint64_t(digit);
+    }
+
+    uint64_t payload = word & PAYLOAD_MASK;
+    if((word >> 57) != check(payload)){ return False; }
+
+    uint8_t unum = uint8_t(payload & 0xF);
+    uint8_t intent = uint8_t(payload >> 4 & 0xF);
+    if(unum < 1 || unum > 11 || intent >= uint8_t(TeamIntent::COUNT)){ return False; }
+
+    out.unum = unum;
+    out.intent = TeamIntent(intent);
+    out.ball_seen = (payload >> 8) & 1;
+    out.ball = {dequantize(payload >> 9 & LEVELS, FIELD_X), dequantize(payload >> 21 & LEVELS, FIELD_Y)};
+    out.position = {dequantize(payload >> 33 & LEVELS, FIELD_X), dequantize(payload >> 45 & LEVELS, FIELD_Y)};
+    return True;
+}
+
+/**
+ * @class TeamKnowledge
+ * @brief O que cada companheiro disse por último, alimentado pelo `hear` (Environment::Parsing::parse_hear).
+ * @details Capacidade fixa e trivialmente copiável: faz parte do WorldState e, portanto, do snapshot
+ * publicado para as demais threads. Diferente do restante do WorldState, não é zerado a cada ciclo:
+ * cada relato carrega o instante em que foi ouvido.
+ */
+class TeamKnowledge {
+public:
+    static constexpr size_t MAX_TEAMMATES = 11;
+
+    /**
+     * @struct Report
+     * @brief Última mensagem de um companheiro.
+     */
+    struct Report {
+        TeamMessage message;
+        float heard_at = -1.0f;  ///< Tempo de partida em que foi ouvida (-1 se nunca)
+        float direction = 0.0f;  ///< Direção de onde veio (graus), 0 se a mensagem é nossa
+        bool self = False;       ///< Mensagem do próprio agente
+    };
+
+    std::array<Report, MAX_TEAMMATES> reports{};  ///< reports[unum - 1]
+    uint32_t received = 0;  ///< Mensagens do time decodificadas
+    uint32_t rejected = 0;  ///< Mensagens do nosso time que não decodificaram
+
+    /**
+     * @brief Registra uma mensagem decodificada.
+     */
+    void update(const TeamMessage& message, float heard_at, float direction, bool self) {
+        Report& report = this->reports[message.unum - 1];
+        report.message = message;
+        report.heard_at = heard_at;
+        report.direction = direction;
+        report.self = self;
+        this->received++;
+    }
+
+    /**
+     * @brief Relato de `unum` ouvido há no máximo `max_age` segundos, ou nullptr.
+     */
+    const Report* fresh(uint8_t unum, float now, float max_age) const {
+        if(unum < 1 || unum > MAX_TEAMMATES){ return nullptr; }
+        const Report& report = this->reports[unum - 1];
+        return (report.heard_at >= 0.0f && now - report.heard_at <= max_age) ? &report : nullptr;
+    }
+
+    /**
+     * @brief Posição da bola no relato mais recente de quem a via (dentro de `max_age`).
+     * @return False se nenhum companheiro relatou a bola recentemente.
+     */
+    bool ball(float now, float max_age, std::array<float, 2>& out) const {
+        const Report* best = nullptr;
+        for(const Report& report : this->reports){
+            if(report.heard_at < 0.0f || !report.message.ball_seen || now - report.heard_at > max_age){ continue; }
+            if(!best || report.heard_at > best->heard_at){ best = &report; }
+        }
+        if(!best){ return False; }
+        out = best->message.ball;
+        return True;
+    }
+};
@@ -1,19 +1,60 @@
 #pragma once
 
+#include "NormalKernels.hpp"
+#include "HermiteTable.hpp"
+
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 
 class FieldNoise {
 public:
 
+    // Parâmetros do ruído do servidor: desvio padrão de cada medida e janela de arredondamento (±)
+    static constexpr double SIGMA_R = 0.0965;  ///< Distância, em % da distância real
+    static constexpr double SIGMA_H = 0.1225;  ///< Ângulo horizontal (graus)
+    static constexpr double SIGMA_V = 0.1480;  ///< Ângulo vertical (graus)
+    static constexpr double ROUNDING = 0.005;
+
+    ///< Conjunto de instruções usado pelas versões em lote
+    static constexpr const char* BATCH_BACKEND = NormalKernels::BestLanes::NAME;
+
+    /**
+     * @enum Mode
+     * @brief Como as versões escalares de log_prob_r/h/v são calculadas.
+     */
+    enum class Mode : uint8_t {
+        EXACT,  ///< erf/erfc/log da biblioteca padrão (log_prob_normal_distribution)
+        TABLE   ///< Tabelas com interpolação cúbica (ver Tables); fora delas, os núcleos de NormalKernels
+    };
+
+    // Erro máximo do modo TABLE em ln P contra os núcleos exatos: absoluto até |ln P| = 1, relativo além (ver math_consistent.cc)
+    static constexpr double TABLE_MAX_ERROR_ANGLE = 1e-12;  ///< log_prob_h e log_prob_v, qualquer deslocamento
+    static constexpr double TABLE_MAX_ERROR_R = 2e-11;      ///< log_prob_r, com d <= 50 m (cresce com d: janela mais estreita)
+
+    /**
+     * @brief Seleciona o modo das versões escalares (as versões em lote não mudam).
+     * @details TABLE constrói as tabelas nesta chamada (~1 ms e 85 KB): faça-a na
+     * inicialização, antes de as threads dos agentes começarem a pontuar hipóteses.
+     */
+    static void set_mode(Mode mode) {
+        if(mode == Mode::TABLE){ (void)__tables(); }
+        __mode = mode;
+    }
+
+    static Mode mode() { return __mode; }
+
     /**
      * @brief Log Prob de uma distância real d, dada uma distância ruidosa r.
      */
     static double log_prob_r(double d, double r) {
+        if(__mode == Mode::TABLE){ return __table_r(d, r); }
         return log_prob_normal_distribution(
             0,
-            0.0965,
-            100.0 * ((r-0.005)/d - 1),
-            100.0 * ((r+0.005)/d - 1)
+            SIGMA_R,
+            100.0 * ((r-ROUNDING)/d - 1),
+            100.0 * ((r+ROUNDING)/d - 1)
         );
     }
 
@@ -21,11 +62,12 @@ public:
      * @brief Log Prob de um ângulo horizontal real h, dada um ângulo ruidoso phi.
      */
     static double log_prob_h(double h, double phi) {
+        if(__mode == Mode::TABLE){ return __table_angle(__tables().h_near, __tables().h_far, SIGMA_H, phi - h); }
         return log_prob_normal_distribution(
             0,
-            0.1225,
-            phi - 0.005 - h,
-            phi + 0.005 - h
+            SIGMA_H,
+            phi - ROUNDING - h,
+            phi + ROUNDING - h
         );
     }
 
@@ -33,16 +75,177 @@ public:
      * @brief Log Prob de um ângulo vertical real v, dada um ângulo ruidoso theta.
      */
     static double log_prob_v(double v, double theta) {
+        if(__mode == Mode::TABLE){ return __table_angle(__tables().v_near, __tables().v_far, SIGMA_V, theta - v); }
         return log_prob_normal_distribution(
             0,
-            0.1480,
-            theta - 0.005 - v,
-            theta + 0.005 - v
+            SIGMA_V,
+            theta - ROUNDING - v,
+            theta + ROUNDING - v
         );
     }
 
+    /**
+     * @brief Versões em lote: out[i] = log_prob_*(real[i], ruidosa[i]) para i em [0, n).
+     * @details
+     * Feitas para o localizador, que pontua milhares de hipóteses de pose contra cada marco visível.
+     * Os elementos são processados de BestLanes::WIDTH em BestLanes::WIDTH (AVX-512, AVX2, SSE2 ou escalar,
+     * conforme a compilação) com os núcleos polinomiais de NormalKernels, sem ramificações por elemento;
+     * a sobra usa os mesmos núcleos em uma pista.
+     *
+     * Concordam com as versões escalares a ~1e-11 onde estas são exatas (ver math_consistent.cc) e seguem
+     * precisas (~1e-14) nas caudas, onde as escalares perdem dígitos na erf e passam à aproximação retangular.
+     * Só compensam com AVX2 + FMA ou AVX-512 (`-march=native`): com SSE2 custam mais que chamar as escalares
+     * em laço (ver `make benchmark_batch`), mas mantêm os mesmos resultados em qualquer compilação.
+     * Os ponteiros podem coincidir (ex: `out == d`). Distâncias reais devem ser positivas.
+     */
+    static void log_prob_r(const double* d, const double* r, double* out, size_t n) { __batch<Kind::R, false>(d, r, out, n); }
+    static void log_prob_h(const double* h, const double* phi, double* out, size_t n) { __batch<Kind::H, false>(h, phi, out, n); }
+    static void log_prob_v(const double* v, const double* theta, double* out, size_t n) { __batch<Kind::V, false>(v, theta, out, n); }
+
+    /**
+     * @brief Versões em lote com uma única observação: out[i] = log_prob_*(real[i], observada).
+     * @details Caso típico do localizador: uma leitura do marco, uma distância/ângulo esperado por hipótese.
+     */
+    static void log_prob_r(const double* d, double r, double* out, size_t n) { __batch<Kind::R, true>(d, &r, out, n); }
+    static void log_prob_h(const double* h, double phi, double* out, size_t n) { __batch<Kind::H, true>(h, &phi, out, n); }
+    static void log_prob_v(const double* v, double theta, double* out, size_t n) { __batch<Kind::V, true>(v, &theta, out, n); }
+
 private:
 
+    enum class Kind { R, H, V };
+
+    static inline Mode __mode = Mode::EXACT;
+
+    /**
+     * @struct Tables
+     * @brief Tabelas do modo TABLE, em unidades normalizadas (x / (sigma * sqrt(2))).
+     * @details
+     * Nos ângulos, a janela ±ROUNDING tem largura fixa, então ln P depende só do deslocamento x = (observado - real):
+     * tabelamos f(x) = ln P(x) + x^2, quase linear nas caudas, em duas faixas: passo 1/8 até |x| = NEAR
+     * (~11° em h, ~13° em v) e passo 1 até |x| = FAR (mais de 360° nos dois). Sem nenhuma função transcendental.
+     *
+     * Na distância a largura da janela depende de d, logo ln P tem duas variáveis. Tabelamos então o
+     * fator G(y) de erfcx(z) = t G(2t - 1), t = 2 / (2 + z) (ver NormalKernels::erfcx_g): y em [-1, 1]
+     * cobre todo z >= 0 com 257 nós, e os dois limites se combinam com um exp e um log, como em
+     * NormalKernels::log_interval_prob.
+     *
+     * Fora das tabelas dos ângulos, vale o núcleo exato de NormalKernels.
+     */
+    struct Tables {
+        static constexpr double NEAR = 64.0;
+        static constexpr double FAR = 2112.0;
+        static constexpr double NEAR_STEP = 1.0 / 8.0;    ///< 513 nós por ângulo
+        static constexpr double FAR_STEP = 1.0;           ///< 2049 nós por ângulo
+        static constexpr double G_STEP = 1.0 / 128.0;     ///< 257 nós
+        static constexpr double RSQRT_PI = 0.56418958354775628695;  ///< 1/sqrt(pi)
+
+        HermiteTable h_near, h_far;
+        HermiteTable v_near, v_far;
+        HermiteTable g;
+
+        Tables() :
+            h_near(0.0, NEAR, NEAR_STEP, [](double x){ return __shifted(SIGMA_H, x); }, [](double x){ return __shifted_slope(SIGMA_H, x); }),
+            h_far(NEAR, FAR, FAR_STEP, [](double x){ return __shifted(SIGMA_H, x); }, [](double x){ return __shifted_slope(SIGMA_H, x); }),
+            v_near(0.0, NEAR, NEAR_STEP, [](double x){ return __shifted(SIGMA_V, x); }, [](double x){ return __shifted_slope(SIGMA_V, x); }),
+            v_far(NEAR, FAR, FAR_STEP, [](double x){ return __shifted(SIGMA_V, x); }, [](double x){ return __shifted_slope(SIGMA_V, x); }),
+            g(-1.0, 1.0, G_STEP, NormalKernels::erfcx_g<NormalKernels::ScalarLanes>, __g_slope)
+        {}
+
+        ///< ln P(x) + x^2 da janela de um ângulo
+        static double __shifted(double sigma, double x) {
+            const double half = ROUNDING / (sigma * NormalKernels::SQRT2);
+            return NormalKernels::log_interval_prob<NormalKernels::ScalarLanes>(x - half, x + half) + x * x;
+        }
+
+        ///< d/dx [ln P(x) + x^2] = (e^{-(x+δ)^2} - e^{-(x-δ)^2}) / (sqrt(pi) P) + 2x
+        static double __shifted_slope(double sigma, double x) {
+            const double half = ROUNDING / (sigma * NormalKernels::SQRT2);
+            double log_p = NormalKernels::log_interval_prob<NormalKernels::ScalarLanes>(x - half, x + half);
+            return RSQRT_PI * (std::exp(-(x + half) * (x + half) - log_p) - std::exp(-(x - half) * (x - half) - log_p)) + 2.0 * x;
+        }
+
+        ///< G'(y), derivando o polinômio de NormalKernels::ERFCX_POLY
+        static double __g_slope(double y) {
+            double slope = 0.0;
+            for(size_t k = 27; k >= 1; k--){ slope = slope * y + double(k) * NormalKernels::ERFCX_POLY[k]; }
+            return slope;
+        }
+    };
+
+    static const Tables& __tables() {
+        static const Tables tables;
+        return tables;
+    }
+
+    static double __table_angle(const HermiteTable& near, const HermiteTable& far, double sigma, double offset) {
+        double x = std::fabs(offset) * (1.0 / (sigma * NormalKernels::SQRT2));
+        if(x < Tables::NEAR){ return near(x) - x * x; }
+        if(x < Tables::FAR){ return far(x) - x * x; }
+        double half = ROUNDING / (sigma * NormalKernels::SQRT2);
+        return NormalKernels::log_interval_prob<NormalKernels::ScalarLanes>(x - half, x + half);
+    }
+
+    ///< erfcx(z), z >= 0, pela tabela de G
+    static double __table_erfcx(const HermiteTable& g, double z) {
+        double t = 2.0 / (2.0 + z);
+        return t * g(t + t - 1.0);
+    }
+
+    static double __table_r(double d, double r) {
+        constexpr double SCALE = 1.0 / (SIGMA_R * NormalKernels::SQRT2);
+        double z1 = 100.0 * ((r - ROUNDING) / d - 1) * SCALE;
+        double z2 = 100.0 * ((r + ROUNDING) / d - 1) * SCALE;
+        double a = std::fmin(std::fabs(z1), std::fabs(z2));
+        double b = std::fmax(std::fabs(z1), std::fabs(z2));
+
+        const HermiteTable& g = __tables().g;
+        double erfcx_a = __table_erfcx(g, a);
+        double erfcx_b = __table_erfcx(g, b);
+        if(z1 * z2 < 0.0){
+            // Lados opostos da média: 2 - erfc(a) - erfc(b)
+            return std::log(2.0 - std::exp(-a * a) * erfcx_a - std::exp(-b * b) * erfcx_b) + NormalKernels::LOG_05;
+        }
+        return std::log(erfcx_a - std::exp((a - b) * (a + b)) * erfcx_b) - a * a + NormalKernels::LOG_05;
+    }
+
+    /**
+     * @brief ln P da observação `obs` dado o valor real `truth`, em L::WIDTH pistas.
+     */
+    template<Kind KIND, class L>
+    static typename L::V __log_prob_lanes(typename L::V truth, typename L::V obs) {
+        using V = typename L::V;
+        constexpr double SIGMA = (KIND == Kind::R) ? SIGMA_R : (KIND == Kind::H) ? SIGMA_H : SIGMA_V;
+        const V scale = L::set1(1.0 / (SIGMA * NormalKernels::SQRT2));
+        V lower = obs - L::set1(ROUNDING);
+        V upper = obs + L::set1(ROUNDING);
+
+        if constexpr (KIND == Kind::R){
+            const V percent = L::set1(100.0);
+            lower = percent * (lower / truth) - percent;
+            upper = percent * (upper / truth) - percent;
+        }
+        else {
+            lower = lower - truth;
+            upper = upper - truth;
+        }
+        return NormalKernels::log_interval_prob<L>(lower * scale, upper * scale);
+    }
+
+    template<Kind KIND, bool BROADCAST>
+    static void __batch(const double* truth, const double* obs, double* out, size_t n) {
+        using L = NormalKernels::BestLanes;
+        using S = NormalKernels::ScalarLanes;
+
+        const size_t body = n - n % L::WIDTH;
+        for(size_t i = 0; i < body; i += L::WIDTH){
+            typename L::V o = BROADCAST ? L::set1(*obs) : L::load(obs + i);
+            L::store(out + i, __log_prob_lanes<KIND, L>(L::load(truth + i), o));
+        }
+        for(size_t i = body; i < n; i++){
+            out[i] = __log_prob_lanes<KIND, S>(truth[i], BROADCAST ? *obs : obs[i]);
+        }
+    }
+
     // Para realizarmos posteriores testes
     friend class UnitTest;
 
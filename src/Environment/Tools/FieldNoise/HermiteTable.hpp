@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <cstddef>
+
+/**
+ * @class HermiteTable
+ * @brief Função tabelada em [x_min, x_max] com passo uniforme e interpolação cúbica de Hermite.
+ * @details
+ * Cada nó guarda o valor e a derivada (já multiplicada pelo passo), lado a lado, de modo que uma
+ * consulta lê uma única linha de cache na maioria dos casos. O erro da interpolação é da ordem de
+ * passo^4 * max|f''''| / 384: com derivadas exatas, poucos nós bastam onde a interpolação linear
+ * precisaria de centenas de vezes mais.
+ *
+ * Construída uma única vez (alocação na inicialização), depois apenas lida: pode ser consultada por várias threads.
+ */
+class HermiteTable {
+private:
+    double __inv_step;
+    double __x_min;
+    std::vector<std::array<double, 2>> __nodes;  ///< {f(x_i), f'(x_i) * passo}
+
+public:
+    /**
+     * @param x_min Início do intervalo tabelado.
+     * @param x_max Fim do intervalo tabelado ((x_max - x_min) múltiplo de `step`).
+     * @param step Distância entre nós (de preferência uma potência de 2, exata em ponto flutuante).
+     * @param f Função a tabelar.
+     * @param df Derivada de `f`.
+     */
+    template<typename F, typename DF>
+    HermiteTable(double x_min, double x_max, double step, F&& f, DF&& df) :
+        __inv_step(1.0 / step),
+        __x_min(x_min)
+    {
+        size_t intervals = size_t((x_max - x_min) / step + 0.5);
+        this->__nodes.resize(intervals + 1);
+        for(size_t i = 0; i <= intervals; i++){
+            double x = x_min + double(i) * step;
+            this->__nodes[i] = {f(x), df(x) * step};
+        }
+    }
+
+    /**
+     * @brief Quantidade de nós (para o relatório de memória).
+     */
+    size_t size() const { return this->__nodes.size(); }
+
+    /**
+     * @brief f(x) interpolada, para x_min <= x <= x_max.
+     */
+    double operator()(double x) const {
+        double u = (x - this->__x_min) * this->__inv_step;
+        size_t i = size_t(u);
+        if(i + 1 >= this->__nodes.size()){ i = this->__nodes.size() - 2; } // x == x_max: último intervalo, t = 1
+        double t = u - double(i);
+        const std::array<double, 2>& p0 = this->__nodes[i];
+        const std::array<double, 2>& p1 = this->__nodes[i + 1];
+
+        // Forma de Horner da base de Hermite em t
+        double dv = p1[0] - p0[0];
+        double c2 = 3.0 * dv - 2.0 * p0[1] - p1[1];
+        double c3 = p0[1] + p1[1] - 2.0 * dv;
+        return p0[0] + t * (p0[1] + t * (c2 + t * c3));
+    }
+};
@@ -0,0 +1,359 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#if defined(__AVX2__) || defined(__AVX512F__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Núcleos vetoriais para ln P(z1 <= Z <= z2) de uma normal, com z já dividido por sigma * sqrt(2).
+ *
+ * O mesmo algoritmo é escrito uma única vez (NormalKernels::log_interval_prob) sobre um conjunto
+ * de "pistas": ScalarLanes (double), Sse2Lanes (2 doubles), Avx2Lanes (4) e Avx512Lanes (8). Assim o caminho
+ * escalar, usado na sobra dos lotes, calcula exatamente a mesma aproximação que os vetoriais.
+ * Sem ramificações por elemento: os dois casos são sempre calculados e escolhidos por máscara.
+ *
+ * A base é a erfc escalonada, erfcx(z) = e^{z^2} erfc(z), que não sofre underflow:
+ *
+ *   erfcx(z) = t G(y),   t = 2 / (2 + z),   y = 2t - 1 = (2 - z) / (2 + z),   z >= 0
+ *
+ * G é suave em y ∈ [-1, 1] (de 1 em z = 0 até 1/(2 sqrt(pi)) em z → ∞). Foi ajustada por 28 termos de
+ * Chebyshev em precisão estendida e convertida para a base de monômios (soma dos |coeficientes| ~ 1,
+ * logo sem perda de precisão), avaliada pelo esquema de Estrin: 5 níveis de FMA em vez de 27 em série.
+ * Erro relativo de G em double < 3e-16.
+ *
+ * Com a = min(|z1|, |z2|) e b = max(|z1|, |z2|):
+ *   - limites em lados opostos da média:  P = (2 - e^{-a^2} erfcx(a) - e^{-b^2} erfcx(b)) / 2
+ *   - no mesmo lado:  ln P = -a^2 + ln(erfcx(a) (1 - e^{(a - b)(a + b)} erfcx(b) / erfcx(a))) + ln(1/2)
+ *
+ * O segundo caso não perde precisão em nenhuma cauda: a^2 sai do logaritmo e só a diferença b^2 - a^2 é exponenciada.
+ * Por elemento: 2 exp, 1 ln e 3 divisões, com exp e ln também polinomiais (redução por potências de 2,
+ * Taylor de grau 13 e série de atanh).
+ */
+namespace NormalKernels {
+
+    ///< G(y) = sum ERFCX_POLY[k] y^k (ver início do arquivo)
+    inline constexpr double ERFCX_POLY[28] = {
+         5.1079135262101150e-01,  3.4358034220690525e-01,  1.3973604627802677e-01,  1.8221115753442773e-02,
+        -1.0755330944710833e-02, -3.2395925339952047e-03,  1.5453060289461833e-03,  4.1864803343182066e-04,
+        -3.3153674643369914e-04, -1.7185738842256242e-05,  7.2235343044675310e-05, -1.7074329152870493e-05,
+        -1.0848026114632092e-05,  8.0600112693257613e-06, -5.6290282576254567e-07, -1.8207283485449644e-06,
+         1.0010818453087822e-06, -3.2089486845521264e-09, -2.8576092154786180e-07,  1.6510847018480489e-07,
+        -1.5108561512988672e-09, -5.7776823680910637e-08,  2.8935307483379802e-08,  6.4552082790214630e-09,
+        -9.7093334261444394e-09,  1.1941835964535130e-09,  1.1999532034678850e-09, -3.3373908081557601e-10
+    };
+
+    inline constexpr double LN2_HI = 6.93147180369123816490e-01;  ///< ln 2 com os bits baixos zerados
+    inline constexpr double LN2_LO = 1.90821492927058770002e-10;  ///< ln 2 - LN2_HI
+    inline constexpr double LOG2E  = 1.44269504088896340736;
+    inline constexpr double SQRT2  = 1.41421356237309504880;
+    inline constexpr double LOG_05 = -0.69314718055994530941;
+    ///< Abaixo disso, e^x é tratado como e^-708 (~3e-308), o que não altera 1 - e^x nem 2 - e^x
+    inline constexpr double EXP_FLOOR = -708.0;
+
+    /**
+     * @struct ScalarLanes
+     * @brief Uma pista: double comum. Usado na sobra dos lotes e fora do x86.
+     */
+    struct ScalarLanes {
+        using V = double;
+        using M = bool;
+        static constexpr size_t WIDTH = 1;
+        static constexpr const char* NAME = "escalar";
+
+        static V set1(double x) { return x; }
+        static V load(const double* p) { return *p; }
+        static void store(double* p, V x) { *p = x; }
+        static V fma(V a, V b, V c) { return a * b + c; }
+        static V abs(V x) { return std::fabs(x); }
+        static V min(V a, V b) { return (a < b) ? a : b; }
+        static V max(V a, V b) { return (a > b) ? a : b; }
+        static M lt(V a, V b) { return a < b; }
+        static M gt(V a, V b) { return a > b; }
+        static V select(M mask, V a, V b) { return mask ? a : b; }
+
+        ///< Arredondamento para o inteiro mais próximo, para |x| < 2^51
+        static V round(V x) { return (x + 0x1.8p52) - 0x1.8p52; }
+
+        ///< 2^n para n inteiro em [-1022, 1023]
+        static V pow2(V n) {
+            uint64_t bits;
+            double biased = n + (0x1.0p52 + 1023.0);
+            std::memcpy(&bits, &biased, sizeof(bits));
+            bits <<= 52;
+            double out;
+            std::memcpy(&out, &bits, sizeof(out));
+            return out;
+        }
+
+        ///< x = m * 2^e com m em [1, 2), para x normal e positivo
+        static V split(V x, V& e) {
+            uint64_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            e = double(int64_t(bits >> 52) - 1023);
+            bits = (bits & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull;
+            double m;
+            std::memcpy(&m, &bits, sizeof(m));
+            return m;
+        }
+    };
+
+#if defined(__SSE2__)
+    /**
+     * @struct Sse2Lanes
+     * @brief Duas pistas em __m128d: o mínimo de qualquer x86-64, sem FMA nem blend.
+     */
+    struct Sse2Lanes {
+        using V = __m128d;
+        using M = __m128d;
+        static constexpr size_t WIDTH = 2;
+        static constexpr const char* NAME = "SSE2";
+
+        static V set1(double x) { return _mm_set1_pd(x); }
+        static V load(const double* p) { return _mm_loadu_pd(p); }
+        static void store(double* p, V x) { _mm_storeu_pd(p, x); }
+        static V fma(V a, V b, V c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+        static V abs(V x) { return _mm_andnot_pd(_mm_set1_pd(-0.0), x); }
+        static V min(V a, V b) { return _mm_min_pd(a, b); }
+        static V max(V a, V b) { return _mm_max_pd(a, b); }
+        static M lt(V a, V b) { return _mm_cmplt_pd(a, b); }
+        static M gt(V a, V b) { return _mm_cmpgt_pd(a, b); }
+        static V select(M mask, V a, V b) { return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b)); }
+        static V round(V x) { return _mm_sub_pd(_mm_add_pd(x, _mm_set1_pd(0x1.8p52)), _mm_set1_pd(0x1.8p52)); }
+
+        static V pow2(V n) {
+            __m128i biased = _mm_castpd_si128(_mm_add_pd(n, _mm_set1_pd(0x1.0p52 + 1023.0)));
+            return _mm_castsi128_pd(_mm_slli_epi64(biased, 52));
+        }
+
+        static V split(V x, V& e) {
+            __m128i bits = _mm_castpd_si128(x);
+            // Expoente como double: 2^52 + expoente enviesado, menos (2^52 + 1023)
+            __m128i exponent = _mm_or_si128(_mm_srli_epi64(bits, 52), _mm_set1_epi64x(0x4330000000000000ll));
+            e = _mm_sub_pd(_mm_castsi128_pd(exponent), _mm_set1_pd(0x1.0p52 + 1023.0));
+            __m128i mantissa = _mm_or_si128(
+                _mm_and_si128(bits, _mm_set1_epi64x(0x000FFFFFFFFFFFFFll)),
+                _mm_set1_epi64x(0x3FF0000000000000ll)
+            );
+            return _mm_castsi128_pd(mantissa);
+        }
+    };
+#endif
+
+#if defined(__AVX2__) && defined(__FMA__)
+    /**
+     * @struct Avx2Lanes
+     * @brief Quatro pistas em __m256d.
+     */
+    struct Avx2Lanes {
+        using V = __m256d;
+        using M = __m256d;
+        static constexpr size_t WIDTH = 4;
+        static constexpr const char* NAME = "AVX2";
+
+        static V set1(double x) { return _mm256_set1_pd(x); }
+        static V load(const double* p) { return _mm256_loadu_pd(p); }
+        static void store(double* p, V x) { _mm256_storeu_pd(p, x); }
+        static V fma(V a, V b, V c) { return _mm256_fmadd_pd(a, b, c); }
+        static V abs(V x) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x); }
+        static V min(V a, V b) { return _mm256_min_pd(a, b); }
+        static V max(V a, V b) { return _mm256_max_pd(a, b); }
+        static M lt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+        static M gt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+        static V select(M mask, V a, V b) { return _mm256_blendv_pd(b, a, mask); }
+        static V round(V x) { return _mm256_round_pd(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        static V pow2(V n) {
+            __m256i biased = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(0x1.0p52 + 1023.0)));
+            return _mm256_castsi256_pd(_mm256_slli_epi64(biased, 52));
+        }
+
+        static V split(V x, V& e) {
+            __m256i bits = _mm256_castpd_si256(x);
+            __m256i exponent = _mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(0x4330000000000000ll));
+            e = _mm256_sub_pd(_mm256_castsi256_pd(exponent), _mm256_set1_pd(0x1.0p52 + 1023.0));
+            __m256i mantissa = _mm256_or_si256(
+                _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFll)),
+                _mm256_set1_epi64x(0x3FF0000000000000ll)
+            );
+            return _mm256_castsi256_pd(mantissa);
+        }
+    };
+#endif
+
+#if defined(__AVX512F__)
+    /**
+     * @struct Avx512Lanes
+     * @brief Oito pistas em __m512d; máscaras em registradores k.
+     */
+    struct Avx512Lanes {
+        using V = __m512d;
+        using M = __mmask8;
+        static constexpr size_t WIDTH = 8;
+        static constexpr const char* NAME = "AVX-512";
+
+        static V set1(double x) { return _mm512_set1_pd(x); }
+        static V load(const double* p) { return _mm512_loadu_pd(p); }
+        static void store(double* p, V x) { _mm512_storeu_pd(p, x); }
+        static V fma(V a, V b, V c) { return _mm512_fmadd_pd(a, b, c); }
+        static V abs(V x) { return _mm512_abs_pd(x); }
+        static V min(V a, V b) { return _mm512_min_pd(a, b); }
+        static V max(V a, V b) { return _mm512_max_pd(a, b); }
+        static M lt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+        static M gt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+        static V select(M mask, V a, V b) { return _mm512_mask_blend_pd(mask, b, a); }
+        static V round(V x) { return _mm512_roundscale_pd(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+        static V pow2(V n) { return _mm512_scalef_pd(_mm512_set1_pd(1.0), n); }
+
+        static V split(V x, V& e) {
+            __m512i bits = _mm512_castpd_si512(x);
+            __m512i exponent = _mm512_or_si512(_mm512_srli_epi64(bits, 52), _mm512_set1_epi64(0x4330000000000000ll));
+            e = _mm512_sub_pd(_mm512_castsi512_pd(exponent), _mm512_set1_pd(0x1.0p52 + 1023.0));
+            __m512i mantissa = _mm512_or_si512(
+                _mm512_and_si512(bits, _mm512_set1_epi64(0x000FFFFFFFFFFFFFll)),
+                _mm512_set1_epi64(0x3FF0000000000000ll)
+            );
+            return _mm512_castsi512_pd(mantissa);
+        }
+    };
+#endif
+
+    ///< Pistas mais largas disponíveis na compilação
+#if defined(__AVX512F__)
+    using BestLanes = Avx512Lanes;
+#elif defined(__AVX2__) && defined(__FMA__)
+    using BestLanes = Avx2Lanes;
+#elif defined(__SSE2__)
+    using BestLanes = Sse2Lanes;
+#else
+    using BestLanes = ScalarLanes;
+#endif
+
+    /**
+     * @brief e^x para x <= 0 (abaixo de EXP_FLOOR, satura em e^EXP_FLOOR).
+     */
+    template<class L>
+    inline typename L::V exp_nonpositive(typename L::V x) {
+        using V = typename L::V;
+        x = L::max(x, L::set1(EXP_FLOOR));
+        V n = L::round(x * L::set1(LOG2E));
+        // x = n ln2 + r, |r| <= ln2 / 2
+        V r = L::fma(n, L::set1(-LN2_HI), x);
+        r = L::fma(n, L::set1(-LN2_LO), r);
+
+        // Taylor de grau 13: último termo omitido < 4e-18 em |r| <= 0.347
+        V p = L::set1(1.0 / 6227020800.0);
+        p = L::fma(p, r, L::set1(1.0 / 479001600.0));
+        p = L::fma(p, r, L::set1(1.0 / 39916800.0));
+        p = L::fma(p, r, L::set1(1.0 / 3628800.0));
+        p = L::fma(p, r, L::set1(1.0 / 362880.0));
+        p = L::fma(p, r, L::set1(1.0 / 40320.0));
+        p = L::fma(p, r, L::set1(1.0 / 5040.0));
+        p = L::fma(p, r, L::set1(1.0 / 720.0));
+        p = L::fma(p, r, L::set1(1.0 / 120.0));
+        p = L::fma(p, r, L::set1(1.0 / 24.0));
+        p = L::fma(p, r, L::set1(1.0 / 6.0));
+        p = L::fma(p, r, L::set1(0.5));
+        p = L::fma(p, r, L::set1(1.0));
+        p = L::fma(p, r, L::set1(1.0));
+        return p * L::pow2(n);
+    }
+
+    /**
+     * @brief ln x para x normal e positivo.
+     * @details x = m 2^e com m em [sqrt(1/2), sqrt(2)); ln m = 2 atanh(s), s = (m - 1)/(m + 1), |s| <= 0.172.
+     */
+    template<class L>
+    inline typename L::V log_positive(typename L::V x) {
+        using V = typename L::V;
+        V e;
+        V m = L::split(x, e);
+        auto big = L::gt(m, L::set1(SQRT2));
+        m = L::select(big, m * L::set1(0.5), m);
+        e = L::select(big, e + L::set1(1.0), e);
+
+        V s = (m - L::set1(1.0)) / (m + L::set1(1.0));
+        V s2 = s * s;
+        // 2 atanh(s) = 2s (1 + s^2/3 + s^4/5 + ...), até s^20 / 21
+        V p = L::set1(1.0 / 21.0);
+        p = L::fma(p, s2, L::set1(1.0 / 19.0));
+        p = L::fma(p, s2, L::set1(1.0 / 17.0));
+        p = L::fma(p, s2, L::set1(1.0 / 15.0));
+        p = L::fma(p, s2, L::set1(1.0 / 13.0));
+        p = L::fma(p, s2, L::set1(1.0 / 11.0));
+        p = L::fma(p, s2, L::set1(1.0 / 9.0));
+        p = L::fma(p, s2, L::set1(1.0 / 7.0));
+        p = L::fma(p, s2, L::set1(1.0 / 5.0));
+        p = L::fma(p, s2, L::set1(1.0 / 3.0));
+        V two_s = s + s;
+        V tail = L::fma(two_s * s2, p, e * L::set1(LN2_LO));
+        return L::fma(e, L::set1(LN2_HI), two_s + tail);
+    }
+
+    /**
+     * @brief G(y) pelo esquema de Estrin: pares, quádruplas, ... combinados com y^2, y^4, y^8 e y^16.
+     */
+    template<class L>
+    inline typename L::V erfcx_g(typename L::V y) {
+        using V = typename L::V;
+        V level[14];
+        for(size_t k = 0; k < 14; k++){
+            level[k] = L::fma(L::set1(ERFCX_POLY[2 * k + 1]), y, L::set1(ERFCX_POLY[2 * k]));
+        }
+        V power = y * y;
+        for(size_t count = 14; count > 1; count = (count + 1) / 2){
+            for(size_t k = 0; k < count / 2; k++){
+                level[k] = L::fma(level[2 * k + 1], power, level[2 * k]);
+            }
+            if(count % 2){ level[count / 2] = level[count - 1]; }
+            power = power * power;
+        }
+        return level[0];
+    }
+
+    /**
+     * @brief ln P(min(z1, z2) <= Z <= max(z1, z2)) para Z normal padrão, com z1 e z2 já divididos por sqrt(2).
+     * @return -inf para intervalos vazios (z1 == z2).
+     */
+    template<class L>
+    inline typename L::V log_interval_prob(typename L::V z1, typename L::V z2) {
+        using V = typename L::V;
+        const V zero = L::set1(0.0);
+        const V one = L::set1(1.0);
+        const V two = L::set1(2.0);
+
+        V a1 = L::abs(z1);
+        V a2 = L::abs(z2);
+        V a = L::min(a1, a2);
+        V b = L::max(a1, a2);
+
+        // t = 2 / (2 + z) dos dois limites com uma só divisão
+        V pa = two + a;
+        V pb = two + b;
+        V inv = one / (pa * pb);
+        V ta = two * pb * inv;
+        V tb = two * pa * inv;
+        V erfcx_a = ta * erfcx_g<L>(ta + ta - one);
+        V erfcx_b = tb * erfcx_g<L>(tb + tb - one);
+
+        auto straddle = L::lt(z1 * z2, zero);
+        V minus_a2 = -(a * a);
+        V exp_b = exp_nonpositive<L>(L::select(straddle, -(b * b), (a - b) * (a + b)));
+
+        // Lados opostos: 2 - erfc(a) - erfc(b). Mesmo lado: 1 - erfc(b) / erfc(a)
+        V straddle_w = two - exp_nonpositive<L>(minus_a2) * erfcx_a - exp_b * erfcx_b;
+        V same_w = one - exp_b * (erfcx_b / erfcx_a);
+
+        V w = L::select(straddle, straddle_w, same_w);
+        V arg = L::select(straddle, w, erfcx_a * w);
+        V base = L::select(straddle, zero, minus_a2);
+
+        V result = log_positive<L>(L::max(arg, L::set1(std::numeric_limits<double>::min()))) + base + L::set1(LOG_05);
+        return L::select(L::gt(w, zero), result, L::set1(-std::numeric_limits<double>::infinity()));
+    }
+}
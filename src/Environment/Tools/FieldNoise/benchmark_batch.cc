@@ -0,0 +1,72 @@
+#include "FieldNoise.hpp"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * Benchmark de FieldNoise: versões escalares (modos EXACT e TABLE) e em lote.
+ *
+ * Uso: ./a.out [hipoteses]
+ *   Simula o localizador: `hipoteses` distâncias/ângulos esperados contra uma leitura de um marco,
+ *   metade perto da leitura (|z| < 3) e metade errada por metros/graus (cauda).
+ *   Imprime ns/elemento de log_prob_r/h/v em cada variante e o ganho sobre o modo exato.
+ * O conjunto de instruções do lote é o da compilação (ver `make benchmark_batch`).
+ */
+
+static constexpr size_t ROUNDS = 50;
+
+template<typename Body>
+static double
+ns_per(size_t count, Body&& body){
+    body(); // Aquecimento
+    auto start = std::chrono::steady_clock::now();
+    for(size_t r = 0; r < ROUNDS; r++){ body(); }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / (double(ROUNDS) * double(count));
+}
+
+int
+main(int argc, char** argv){
+
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4096;
+
+    std::mt19937_64 rng(5);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    std::vector<double> d(count), angle(count), out(count);
+    const double reading = 8.0;
+    for(size_t i = 0; i < count; i++){
+        bool near = (i % 2) == 0;
+        d[i] = reading * (1.0 + (near ? 0.004 : 0.3) * unit(rng));
+        angle[i] = (near ? 0.5 : 40.0) * unit(rng);
+    }
+
+    double sink = 0.0;
+    struct Row { const char* name; double exact; double table; double batch; };
+    Row rows[3] = {{"log_prob_r", 0, 0, 0}, {"log_prob_h", 0, 0, 0}, {"log_prob_v", 0, 0, 0}};
+
+    auto scalar_loops = [&](double Row::* column){
+        rows[0].*column = ns_per(count, [&](){ for(size_t i = 0; i < count; i++){ out[i] = FieldNoise::log_prob_r(d[i], reading); } sink += out[0]; });
+        rows[1].*column = ns_per(count, [&](){ for(size_t i = 0; i < count; i++){ out[i] = FieldNoise::log_prob_h(angle[i], 0.0); } sink += out[0]; });
+        rows[2].*column = ns_per(count, [&](){ for(size_t i = 0; i < count; i++){ out[i] = FieldNoise::log_prob_v(angle[i], 0.0); } sink += out[0]; });
+    };
+    scalar_loops(&Row::exact);
+    FieldNoise::set_mode(FieldNoise::Mode::TABLE);
+    scalar_loops(&Row::table);
+    FieldNoise::set_mode(FieldNoise::Mode::EXACT);
+
+    rows[0].batch = ns_per(count, [&](){ FieldNoise::log_prob_r(d.data(), reading, out.data(), count); sink += out[0]; });
+    rows[1].batch = ns_per(count, [&](){ FieldNoise::log_prob_h(angle.data(), 0.0, out.data(), count); sink += out[0]; });
+    rows[2].batch = ns_per(count, [&](){ FieldNoise::log_prob_v(angle.data(), 0.0, out.data(), count); sink += out[0]; });
+
+    std::printf("\n=== FieldNoise (lote: %s), %zu hipoteses, ns/elemento ===\n", FieldNoise::BATCH_BACKEND, count);
+    std::printf("%-12s %10s %10s %8s %10s %8s\n", "funcao", "exato", "tabela", "ganho", "lote", "ganho");
+    for(const Row& row : rows){
+        std::printf("%-12s %10.2f %10.2f %7.1fx %10.2f %7.1fx\n",
+            row.name, row.exact, row.table, row.exact / row.table, row.batch, row.exact / row.batch);
+    }
+
+    return (sink == 0.12345) ? 1 : 0;
+}
@@ -1,212 +1,369 @@
 #include "FieldNoise.hpp"
-#include <iostream>
-#include <fstream>
-#include <cmath>
-#include <vector>
-#include <iomanip>
-#include <limits>
-
-double log_prob_naive(double mean, double std, double interval1, double interval2) {
-    const double SQRT2 = std::sqrt(2.0);
-    const double LOG_05 = std::log(0.5);
 
-    // Z-scores
-    double z1 = (mean - interval1) / (std * SQRT2);
-    double z2 = (mean - interval2) / (std * SQRT2);
-
-    // FIX: Usar std::fabs para garantir que a diferença seja positiva
-    // Probabilidade = |erf(z1) - erf(z2)| / 2
-    double diff = std::fabs(std::erf(z1) - std::erf(z2));
-
-    if (diff <= 0.0) return -std::numeric_limits<double>::infinity();
-    return std::log(diff) + LOG_05;
+#include <vector>
+#include <string>
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Benchmark e precisão de FieldNoise: variantes ingênua, exata, tabela e em lote (SIMD), medidas juntas.
+ *
+ * Uso: ./a.out [--rounds N] [--save arquivo] [--compare arquivo]
+ *
+ * Tempo: ns/chamada de log_prob_r/h/v sobre 4096 hipóteses, em duas cargas do localizador:
+ *   - perto: leituras a menos de 3 desvios da hipótese (|z| < 3);
+ *   - cauda: hipóteses erradas por metros/graus, onde as variantes trocam de ramo.
+ * Cada medida é precedida de rodadas de aquecimento e repetida `--rounds` vezes (padrão 31):
+ * imprime mediana, mínimo e desvio padrão entre as repetições.
+ *
+ * Precisão: varredura determinística de todo o domínio (ângulos até 180°, distâncias de 0.5 a 50 m com
+ * erro de até ±90%) contra uma referência em long double. O erro em ln P é absoluto até |ln P| = 1 e
+ * relativo além (o mesmo critério de math_consistent.cc); ULP conta só onde |ln P| > 1, longe de ln P = 0.
+ * Também é impresso o |z| (z já dividido por sqrt(2)) onde ocorre o pior erro.
+ *
+ * `--save` grava uma linha por função e variante ("funcao variante ns_perto ns_cauda erro ulp"),
+ * e `--compare` imprime a variação em relação a um arquivo gravado antes da mudança.
+ */
+
+static constexpr size_t COUNT = 4096;
+static constexpr size_t WARMUP = 5;
+
+static double sink = 0.0; ///< Impede que o compilador descarte os laços medidos
+
+// ============================================================================
+// FUNÇÕES E VARIANTES
+// ============================================================================
+
+/**
+ * @struct Function
+ * @brief Uma das medidas do servidor: como obter z1, z2 e as chamadas escalar e em lote de FieldNoise.
+ */
+struct Function {
+    const char* name;
+    double (*scalar)(double, double);
+    void (*batch)(const double*, const double*, double*, size_t);
+    void (*bounds)(double truth, double obs, double& z1, double& z2);  ///< Limites da janela, já divididos por sigma * sqrt(2)
+};
+
+static void
+angle_bounds(double sigma, double truth, double obs, double& z1, double& z2){
+    const double scale = 1.0 / (sigma * std::sqrt(2.0));
+    z1 = (obs - FieldNoise::ROUNDING - truth) * scale;
+    z2 = (obs + FieldNoise::ROUNDING - truth) * scale;
 }
 
-static double erf_aux(double a){
-    double r, s, t, u;
-
-    t = fabs (a);
-    s = a * a;
-
-    r = fma (-5.6271698458222802e-018, t, 4.8565951833159269e-016);
-    u = fma (-1.9912968279795284e-014, t, 5.1614612430130285e-013);
-    r = fma (r, s, u);
-    r = fma (r, t, -9.4934693735334407e-012);
-    r = fma (r, t,  1.3183034417266867e-010);
-    r = fma (r, t, -1.4354030030124722e-009);
-    r = fma (r, t,  1.2558925114367386e-008);
-    r = fma (r, t, -8.9719702096026844e-008);
-    r = fma (r, t,  5.2832013824236141e-007);
-    r = fma (r, t, -2.5730580226095829e-006);
-    r = fma (r, t,  1.0322052949682532e-005);
-    r = fma (r, t, -3.3555264836704290e-005);
-    r = fma (r, t,  8.4667486930270974e-005);
-    r = fma (r, t, -1.4570926486272249e-004);
-    r = fma (r, t,  7.1877160107951816e-005);
-    r = fma (r, t,  4.9486959714660115e-004);
-    r = fma (r, t, -1.6221099717135142e-003);
-    r = fma (r, t,  1.6425707149019371e-004);
-    r = fma (r, t,  1.9148914196620626e-002);
-    r = fma (r, t, -1.0277918343487556e-001);
-    r = fma (r, t, -6.3661844223699315e-001);
-    r = fma (r, t, -1.2837929411398119e-001);
-    r = fma (r, t, -t);
-
-    return r;
+static void
+distance_bounds(double d, double r, double& z1, double& z2){
+    const double scale = 1.0 / (FieldNoise::SIGMA_R * std::sqrt(2.0));
+    z1 = 100.0 * ((r - FieldNoise::ROUNDING) / d - 1) * scale;
+    z2 = 100.0 * ((r + FieldNoise::ROUNDING) / d - 1) * scale;
 }
 
-double log_prob_normal_custom(double mean, double std, double interval1, double interval2) {
-
-    static const double SQRT2 = std::sqrt(2.0);
-    static const double LOG_05 = std::log(0.5);
-
-    // Otimização: inverso para multiplicar
-    const double inv_denom = 1.0 / (std * SQRT2);
-
-    double erf1_x = (mean - interval1) * inv_denom;
-    double erf2_x = (mean - interval2) * inv_denom;
-
-    // --- ZONA SEGURA (Perto da média) ---
-    // Se |z| < 2.0 ou se os intervalos cruzam a média (sinais opostos)
-    // Usamos a diferença direta das funções de erro, garantindo valor absoluto
-    if (std::fabs(erf1_x) < 2.0 || std::fabs(erf2_x) < 2.0 || ((erf1_x > 0) != (erf2_x > 0))) {
-        double diff = std::fabs(std::erf(erf1_x) - std::erf(erf2_x));
+static const Function FUNCTIONS[3] = {
+    {"r", [](double d, double r){ return FieldNoise::log_prob_r(d, r); },
+          [](const double* d, const double* r, double* out, size_t n){ FieldNoise::log_prob_r(d, r, out, n); },
+          distance_bounds},
+    {"h", [](double h, double phi){ return FieldNoise::log_prob_h(h, phi); },
+          [](const double* h, const double* phi, double* out, size_t n){ FieldNoise::log_prob_h(h, phi, out, n); },
+          [](double h, double phi, double& z1, double& z2){ angle_bounds(FieldNoise::SIGMA_H, h, phi, z1, z2); }},
+    {"v", [](double v, double theta){ return FieldNoise::log_prob_v(v, theta); },
+          [](const double* v, const double* theta, double* out, size_t n){ FieldNoise::log_prob_v(v, theta, out, n); },
+          [](double v, double theta, double& z1, double& z2){ angle_bounds(FieldNoise::SIGMA_V, v, theta, z1, z2); }},
+};
+
+/**
+ * @brief Variante ingênua: ln(|erf(z2) - erf(z1)| / 2), como a primeira versão do modelo.
+ * Exata perto da média; a diferença se cancela a zero por volta de |z| = 6 (-inf).
+ */
+static double
+naive_log_prob(const Function& f, double truth, double obs){
+    double z1, z2;
+    f.bounds(truth, obs, z1, z2);
+    return std::log(std::fabs(std::erf(z2) - std::erf(z1))) + NormalKernels::LOG_05;
+}
 
-        // Proteção contra log(0) caso os intervalos sejam idênticos
-        if (diff <= 0.0) return -std::numeric_limits<double>::infinity();
+enum class Variant { NAIVE, EXACT, TABLE, BATCH };
 
-        return std::log(diff) + LOG_05;
+static const char* variant_name(Variant variant){
+    switch(variant){
+        case Variant::NAIVE: return "ingenua";
+        case Variant::EXACT: return "exata";
+        case Variant::TABLE: return "tabela";
+        default:             return "lote";
     }
-
-    // --- ZONA CRÍTICA (Caudas longas) ---
-    // Aqui usamos erf_aux. Não importa se z é positivo ou negativo,
-    // pois erf_aux usa fabs() internamente e retorna valores logarítmicos negativos.
-
-    double val1 = erf_aux(erf1_x);
-    double val2 = erf_aux(erf2_x);
-
-    // ALGORITMO ROBUSTO (Log-Difference-Exp):
-    // Queremos calcular log( | exp(val1) - exp(val2) | )
-    // Matematicamente equivalente a: max_val + log( 1 - exp(min_val - max_val) )
-    // Isso garante que o argumento do exp seja sempre negativo (seguro) e
-    // o argumento do log seja sempre positivo (seguro).
-
-    double max_val = std::max(val1, val2); // O valor "menos negativo" (maior probabilidade)
-    double min_val = std::min(val1, val2); // O valor "mais negativo"
-
-    double diff_exp = min_val - max_val; // Sempre <= 0
-
-    // Se diff_exp for muito pequeno (ex: -50), exp será 0. log(1) será 0. Retorna max_val.
-    // Se diff_exp for 0 (intervalos iguais), log(0) -> -inf.
-
-    return max_val + std::log(1.0 - std::exp(diff_exp)) + LOG_05;
 }
 
-static double log_prob_hybrid(double mean, double std, double interval1, double interval2) {
-
-    // Constantes Matemáticas Estáticas
-    static constexpr double SQRT2 = 1.41421356237309504880;
-    static constexpr double LOG_05 = -0.69314718055994530941; // ln(0.5)
+/**
+ * @brief out[i] = ln P(obs[i] | truth[i]) pela variante escolhida.
+ */
+static void
+evaluate(const Function& f, Variant variant, const double* truth, const double* obs, double* out, size_t n){
+    switch(variant){
+        case Variant::NAIVE:
+            for(size_t i = 0; i < n; i++){ out[i] = naive_log_prob(f, truth[i], obs[i]); }
+            break;
+        case Variant::EXACT:
+        case Variant::TABLE:
+            FieldNoise::set_mode(variant == Variant::TABLE ? FieldNoise::Mode::TABLE : FieldNoise::Mode::EXACT);
+            for(size_t i = 0; i < n; i++){ out[i] = f.scalar(truth[i], obs[i]); }
+            FieldNoise::set_mode(FieldNoise::Mode::EXACT);
+            break;
+        case Variant::BATCH:
+            f.batch(truth, obs, out, n);
+            break;
+    }
+}
 
-    // Constante para a Zona 3: ln(sqrt(pi))
-    // Derivação: ln(PDF) + ln(delta) requer termos que simplificam para ln(sqrt(pi))
-    static constexpr double LOG_SQRT_PI = 0.57236494292470008707;
+// ============================================================================
+// TEMPO
+// ============================================================================
+
+/**
+ * @struct Timing
+ * @brief Estatísticas de ns/chamada entre as repetições.
+ */
+struct Timing {
+    double median = 0;
+    double min = 0;
+    double stddev = 0;
+};
+
+static Timing
+time_variant(const Function& f, Variant variant, const std::vector<double>& truth, const std::vector<double>& obs, size_t rounds){
+    std::vector<double> out(truth.size());
+    // A troca de modo fica fora da região medida: o laço escalar roda direto no modo da variante
+    auto pass = [&](){
+        if(variant == Variant::NAIVE){ for(size_t i = 0; i < COUNT; i++){ out[i] = naive_log_prob(f, truth[i], obs[i]); } }
+        else if(variant == Variant::BATCH){ f.batch(truth.data(), obs.data(), out.data(), COUNT); }
+        else { for(size_t i = 0; i < COUNT; i++){ out[i] = f.scalar(truth[i], obs[i]); } }
+        sink += out[COUNT / 2];
+    };
+
+    if(variant == Variant::TABLE){ FieldNoise::set_mode(FieldNoise::Mode::TABLE); }
+    for(size_t r = 0; r < WARMUP; r++){ pass(); }
+
+    std::vector<double> samples(rounds);
+    for(size_t r = 0; r < rounds; r++){
+        auto start = std::chrono::steady_clock::now();
+        pass();
+        samples[r] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / double(COUNT);
+    }
+    FieldNoise::set_mode(FieldNoise::Mode::EXACT);
 
-    // OTIMIZAÇÃO: Combina divisões.
-    // O argumento da erf é (x - mu) / (sigma * sqrt(2)).
-    // Calculamos o inverso disso para usar multiplicação (mais rápido que divisão).
-    const double inv_denom = 1.0 / (std * SQRT2);
+    Timing timing;
+    double mean = 0.0;
+    for(double s : samples){ mean += s; }
+    mean /= double(rounds);
+    for(double s : samples){ timing.stddev += (s - mean) * (s - mean); }
+    timing.stddev = std::sqrt(timing.stddev / double(rounds));
+    std::sort(samples.begin(), samples.end());
+    timing.median = samples[rounds / 2];
+    timing.min = samples[0];
+    return timing;
+}
 
-    // Z-scores normalizados para erf/erfc (já divididos por sqrt(2))
-    double z1 = (interval1 - mean) * inv_denom;
-    double z2 = (interval2 - mean) * inv_denom;
+/**
+ * @brief Hipóteses do localizador contra uma leitura: `near` com |z| < 3, senão erradas por metros/graus.
+ */
+static void
+workload(size_t index, bool near, std::vector<double>& truth, std::vector<double>& obs){
+    std::mt19937_64 rng(5 + index);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    truth.resize(COUNT);
+    obs.resize(COUNT);
+    for(size_t i = 0; i < COUNT; i++){
+        if(index == 0){
+            truth[i] = 0.3 + 30.0 * std::fabs(unit(rng));
+            obs[i] = truth[i] * (1.0 + (near ? 0.004 : 0.3) * unit(rng));
+        }
+        else {
+            truth[i] = 90.0 * unit(rng);
+            obs[i] = truth[i] + (near ? 0.5 : 40.0) * unit(rng);
+        }
+    }
+}
 
-    // Pré-cálculo dos valores absolutos (usados em todas as ramificações)
-    double abs_z1 = std::fabs(z1);
-    double abs_z2 = std::fabs(z2);
+// ============================================================================
+// PRECISÃO
+// ============================================================================
+
+/**
+ * @brief erfcx(z) = e^{z^2} erfc(z) em long double, z >= 0; série assintótica onde erfcl já estaria no fim do expoente.
+ */
+static long double
+reference_erfcx(long double z){
+    if(z < 50.0L){ return expl(z * z) * erfcl(z); }
+    long double h = 0.5L / (z * z), term = 1.0L, sum = 1.0L;
+    for(int n = 1; n < 12; n++){
+        term *= -(2 * n - 1) * h;
+        sum += term;
+    }
+    return sum / (z * sqrtl(3.14159265358979323846264338327950288L));
+}
 
-    // --- 1. ZONA SEGURA (Perto da média, |z| < 1) ---
-    // A precisão da erf padrão é perfeita aqui.
-    double diff = std::fabs(std::erf(z1) - std::erf(z2));
+/**
+ * @brief ln P(min(z1, z2) <= Z <= max(z1, z2)) em long double, válida em todo o domínio (|z| até ~1e4).
+ */
+static long double
+reference_log_prob(long double z1, long double z2){
+    if(z1 > z2){ std::swap(z1, z2); }
+    if(z1 < 0 && z2 > 0){ return logl(erfl(z2) - erfl(z1)) + logl(0.5L); }
+    long double a = std::min(fabsl(z1), fabsl(z2));
+    long double b = std::max(fabsl(z1), fabsl(z2));
+    return -a * a + logl(reference_erfcx(a) - expl((a - b) * (a + b)) * reference_erfcx(b)) + logl(0.5L);
+}
 
-    // Verificação rápida para evitar log(0) se intervalos forem iguais
-    if (diff > 0.0) {
-        return std::log(diff) + LOG_05;
+/**
+ * @struct Accuracy
+ * @brief Pior erro de uma variante na varredura.
+ */
+struct Accuracy {
+    double error = 0;  ///< Absoluto até |ln P| = 1, relativo além
+    double ulp = 0;    ///< Em |ln P| > 1
+    double worst_z = 0;
+};
+
+/**
+ * @brief Pontos da varredura: (real, observada), cobrindo de z = 0 ao fim do domínio de cada função.
+ */
+static void
+sweep(size_t index, std::vector<double>& truth, std::vector<double>& obs){
+    truth.clear();
+    obs.clear();
+    if(index == 0){
+        for(double d : {0.5, 2.0, 8.0, 20.0, 50.0}){
+            for(double q = -0.9; q <= 0.9; q += 2e-5){ truth.push_back(d); obs.push_back(d * (1.0 + q)); }
+        }
     }
-    // Se diff <= 0, cai para o retorno de erro no final da função
-    // --- 2. ZONA DE CAUDA (Usando erfc) ---
-    // Calcula |erfc(|z1|) - erfc(|z2|)|
-    // Usamos fabs nos inputs pois erfc(x) = 2 - erfc(-x), a diferença simétrica se mantém.
-    double erfc1 = std::erfc(abs_z1);
-    double erfc2 = std::erfc(abs_z2);
-
-    diff = std::fabs(erfc1 - erfc2);
-
-    // Se o double conseguiu representar a diferença (> 1e-308), retornamos.
-    if (diff > std::numeric_limits<double>::min()) {
-        return std::log(diff) + LOG_05;
+    else {
+        for(double offset = -180.0; offset <= 180.0; offset += 1e-3){ truth.push_back(10.0); obs.push_back(10.0 + offset); }
     }
-
-    // --- 3. ZONA EXTREMA (Underflow Assintótico) ---
-    // Se chegamos aqui, diff == 0.0. Estamos na cauda longínqua (Z > ~26).
-    // A probabilidade é minúscula. Usamos a aproximação retangular:
-    // P ~= PDF(z_closer) * largura_do_intervalo
-
-    // Determina quem está mais perto do pico (menor Z absoluto tem maior probabilidade)
-    double z_closer_norm = std::min(abs_z1, abs_z2);
-
-    // Calcula a largura do intervalo normalizado
-    double delta_z_norm = std::fabs(z1 - z2);
-
-    if (delta_z_norm == 0.0) return -std::numeric_limits<double>::infinity();
-
-    // FÓRMULA OTIMIZADA LOG-PDF:
-    // Originalmente: ln(P) = -0.5 * z_raw^2 - ln(sqrt(2pi)) + ln(width_raw)
-    // Substituindo z_raw = z_norm * sqrt(2) e simplificando as constantes:
-    // Resulta em: -z_norm^2 - ln(sqrt(pi)) + ln(delta_z_norm)
-
-    double term_exp = -(z_closer_norm * z_closer_norm); // -z^2
-
-    return term_exp - LOG_SQRT_PI + std::log(delta_z_norm);
 }
 
-int main() {
-    // Teste de Benchmark
-    std::ofstream file("benchmark_data.txt");
-    file << "x_pos,naive,hybrid,custom\n";
-
-    // Configurações de Erro de Distância Por Exemplo
-    double mean = 0.0;
-    double std_dev = 0.1480;
-
-    // Vamos testar x indo de 0 até 12 (onde a precisão quebra)
-    // Para cada x, calculamos a chance de cair entre x e x+0.5
-    for (double x = 0.0; x <= 12.0; x += 0.1) {
-
-        // Intervalo: De x até x + 0.5
-        // Para garantir a ordem correta na subtração interna (maior - menor área),
-        // passamos o intervalo mais "distante" primeiro ou seguimos a lógica da função.
+static Accuracy
+measure_accuracy(const Function& f, Variant variant, const std::vector<double>& truth, const std::vector<double>& obs,
+                 const std::vector<long double>& reference){
+    std::vector<double> out(truth.size());
+    evaluate(f, variant, truth.data(), obs.data(), out.data(), truth.size());
+
+    Accuracy accuracy;
+    for(size_t i = 0; i < truth.size(); i++){
+        long double ref = reference[i];
+        double error = double(fabsl(out[i] - ref) / std::max(1.0L, fabsl(ref)));
+        if(std::isnan(error)){ error = INFINITY; }
+        if(error > accuracy.error){
+            double z1, z2;
+            f.bounds(truth[i], obs[i], z1, z2);
+            accuracy.error = error;
+            accuracy.worst_z = 0.5 * std::fabs(z1 + z2);
+        }
+        if(fabsl(ref) > 1.0L){
+            double rounded = double(ref);
+            double ulp = std::nextafter(std::fabs(rounded), INFINITY) - std::fabs(rounded);
+            accuracy.ulp = std::max(accuracy.ulp, double(fabsl(out[i] - ref) / ulp));
+        }
+    }
+    return accuracy;
+}
 
-        double val_start = x;
-        double val_end = x + 0.5;
+// ============================================================================
+// RELATÓRIO
+// ============================================================================
+
+/**
+ * @struct Result
+ * @brief Linha do relatório (e da linha de base gravada com --save).
+ */
+struct Result {
+    Timing near;
+    Timing tail;
+    Accuracy accuracy;
+};
+
+int
+main(int argc, char** argv){
+
+    size_t rounds = 31;
+    const char* save = nullptr;
+    const char* compare = nullptr;
+    for(int i = 1; i < argc; i++){
+        if(std::strcmp(argv[i], "--rounds") == 0 && i + 1 < argc){ rounds = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10)); }
+        else if(std::strcmp(argv[i], "--save") == 0 && i + 1 < argc){ save = argv[++i]; }
+        else if(std::strcmp(argv[i], "--compare") == 0 && i + 1 < argc){ compare = argv[++i]; }
+        else { std::fprintf(stderr, "Argumento invalido: %s\n", argv[i]); return 1; }
+    }
 
-        // 1. Naive
-        double y_naive = log_prob_naive(mean, std_dev, val_end, val_start);
+    const Variant variants[4] = {Variant::NAIVE, Variant::EXACT, Variant::TABLE, Variant::BATCH};
+    std::map<std::string, Result> results;  ///< "funcao variante"
+
+    std::vector<double> truth, obs;
+    std::vector<long double> reference;
+    for(size_t index = 0; index < 3; index++){
+        const Function& f = FUNCTIONS[index];
+
+        sweep(index, truth, obs);
+        reference.resize(truth.size());
+        for(size_t i = 0; i < truth.size(); i++){
+            double z1, z2;
+            f.bounds(truth[i], obs[i], z1, z2);
+            reference[i] = reference_log_prob(z1, z2);
+        }
+        for(Variant variant : variants){
+            results[std::string(f.name) + " " + variant_name(variant)].accuracy = measure_accuracy(f, variant, truth, obs, reference);
+        }
+
+        for(bool near : {true, false}){
+            workload(index, near, truth, obs);
+            for(Variant variant : variants){
+                Result& result = results[std::string(f.name) + " " + variant_name(variant)];
+                (near ? result.near : result.tail) = time_variant(f, variant, truth, obs, rounds);
+            }
+        }
+    }
 
-        // 2. Hybrid
-        double y_hybrid = log_prob_hybrid(mean, std_dev, val_end, val_start);
+    std::printf("\n=== FieldNoise: %zu hipoteses, %zu repeticoes, lote %s ===\n", COUNT, rounds, FieldNoise::BATCH_BACKEND);
+    std::printf("%-12s %26s %26s %10s %10s %8s\n", "", "perto ns (med/min/desvio)", "cauda ns (med/min/desvio)", "erro ln P", "ULP", "pior |z|");
+    for(const Function& f : FUNCTIONS){
+        for(Variant variant : variants){
+            const Result& r = results[std::string(f.name) + " " + variant_name(variant)];
+            std::printf("%-2s %-9s %10.2f %7.2f %7.2f %10.2f %7.2f %7.2f %10.2e %10.2e %8.2f\n",
+                f.name, variant_name(variant),
+                r.near.median, r.near.min, r.near.stddev, r.tail.median, r.tail.min, r.tail.stddev,
+                r.accuracy.error, r.accuracy.ulp, r.accuracy.worst_z);
+        }
+    }
 
-        // 3. Custom
-        double y_custom = log_prob_normal_custom(mean, std_dev, val_end, val_start);
+    // Linha de base: "funcao variante ns_perto ns_cauda erro ulp" por linha
+    if(compare){
+        FILE* file = std::fopen(compare, "r");
+        if(!file){ std::fprintf(stderr, "Linha de base invalida: %s\n", compare); return 1; }
+        char name[16], variant[16];
+        double near, tail, error, ulp;
+        std::printf("\n");
+        while(std::fscanf(file, "%15s %15s %lf %lf %lf %lf", name, variant, &near, &tail, &error, &ulp) == 6){
+            auto it = results.find(std::string(name) + " " + variant);
+            if(it == results.end()){ continue; }
+            const Result& now = it->second;
+            std::printf("%-2s %-9s vs base: perto %+6.1f%% | cauda %+6.1f%% | erro %.2e -> %.2e\n", name, variant,
+                100.0 * (now.near.median / near - 1.0), 100.0 * (now.tail.median / tail - 1.0), error, now.accuracy.error);
+        }
+        std::fclose(file);
+    }
 
-        // Salvando
-        file << std::fixed << std::setprecision(16)
-             << x << ","
-             << y_naive << ","
-             << y_hybrid << ","
-             << y_custom << "\n";
+    if(save){
+        FILE* file = std::fopen(save, "w");
+        if(!file){ std::fprintf(stderr, "Nao foi possivel gravar: %s\n", save); return 1; }
+        for(const auto& [name, r] : results){
+            std::fprintf(file, "%s %.3f %.3f %.3e %.3e\n", name.c_str(), r.near.median, r.tail.median, r.accuracy.error, r.accuracy.ulp);
+        }
+        std::fclose(file);
     }
 
-    file.close();
-    return 0;
-}
\ No newline at end of file
+    return (sink == 0.12345) ? 1 : 0;
+}
@@ -3,7 +3,10 @@
 #include <vector>
 #include <iomanip>
 #include <limits>
+#include <sstream>
 #include <string>
+#include <random>
+#include <algorithm>
 
 // Supondo que o arquivo header esteja disponível
 #include "FieldNoise.hpp"
@@ -155,6 +158,169 @@ public:
             passed ? "" : "Diff real: " + std::to_string(actual_diff) + " Esperado: " + std::to_string(expected_diff));
     }
 
+    // ============================================================================
+    // TESTES DA API EM LOTE (NormalKernels)
+    // ============================================================================
+
+    /**
+     * @brief Referência em precisão estendida: ln P(min <= X <= max), com z já dividido por sqrt(2).
+     */
+    static long double reference_log_prob(long double z1, long double z2) {
+        if(z1 > z2){ std::swap(z1, z2); }
+        long double p;
+        if(z1 < 0 && z2 > 0){ p = erfl(z2) - erfl(z1); }
+        else { p = erfcl(std::min(fabsl(z1), fabsl(z2))) - erfcl(std::max(fabsl(z1), fabsl(z2))); }
+        return logl(p) + logl(0.5L);
+    }
+
+    /**
+     * @brief TESTE 8: Lote x escalar perto da média (|z| < 3), onde log_prob_* é exata.
+     */
+    void test_batch_matches_scalar() {
+        const size_t N = 4099; // Não múltiplo da largura: exercita a sobra escalar
+        std::mt19937_64 rng(7);
+        std::uniform_real_distribution<double> unit(-1.0, 1.0);
+        std::vector<double> truth(N), obs(N), out(N);
+
+        const char* names[3] = {"r", "h", "v"};
+        for(int kind = 0; kind < 3; kind++){
+            for(size_t i = 0; i < N; i++){
+                if(kind == 0){ truth[i] = 0.3 + 30.0 * std::fabs(unit(rng)); obs[i] = truth[i] * (1.0 + 0.004 * unit(rng)); }
+                else { truth[i] = 90.0 * unit(rng); obs[i] = truth[i] + 0.5 * unit(rng); }
+            }
+            if(kind == 0){ FieldNoise::log_prob_r(truth.data(), obs.data(), out.data(), N); }
+            if(kind == 1){ FieldNoise::log_prob_h(truth.data(), obs.data(), out.data(), N); }
+            if(kind == 2){ FieldNoise::log_prob_v(truth.data(), obs.data(), out.data(), N); }
+
+            double worst = 0.0;
+            for(size_t i = 0; i < N; i++){
+                double scalar = (kind == 0) ? FieldNoise::log_prob_r(truth[i], obs[i])
+                              : (kind == 1) ? FieldNoise::log_prob_h(truth[i], obs[i])
+                              : FieldNoise::log_prob_v(truth[i], obs[i]);
+                worst = std::max(worst, std::fabs(out[i] - scalar));
+            }
+            bool passed = worst < 1e-9;
+            std::ostringstream details;
+            details << "max |diff| = " << worst;
+            print_result(std::string("Lote: log_prob_") + names[kind] + " == escalar (|z| < 3)", passed, details.str());
+        }
+    }
+
+    /**
+     * @brief TESTE 9: Precisão em toda a faixa de z, contra a referência em long double.
+     * A versão escalar é medida junto: na cauda ela cancela a erf e, além de z ~ 26, usa a aproximação retangular.
+     */
+    void test_batch_full_range() {
+        const size_t N = 20000;
+        std::mt19937_64 rng(11);
+        std::uniform_real_distribution<double> unit(-1.0, 1.0);
+        std::vector<double> h(N), phi(N), out(N);
+        for(size_t i = 0; i < N; i++){
+            phi[i] = 0.0;
+            h[i] = 15.0 * unit(rng); // |z| até ~87
+        }
+        FieldNoise::log_prob_h(h.data(), phi.data(), out.data(), N);
+
+        const double scale = 1.0 / (FieldNoise::SIGMA_H * std::sqrt(2.0));
+        double worst_batch = 0.0, worst_scalar = 0.0;
+        for(size_t i = 0; i < N; i++){
+            long double ref = reference_log_prob((phi[i] - FieldNoise::ROUNDING - h[i]) * scale, (phi[i] + FieldNoise::ROUNDING - h[i]) * scale);
+            double tol = std::max(1.0L, fabsl(ref));
+            worst_batch = std::max(worst_batch, double(fabsl(out[i] - ref) / tol));
+            worst_scalar = std::max(worst_scalar, double(fabsl(FieldNoise::log_prob_h(h[i], phi[i]) - ref) / tol));
+        }
+        bool passed = worst_batch < 1e-12;
+        std::ostringstream details;
+        details << "erro rel. lote " << worst_batch << ", escalar " << worst_scalar;
+        print_result("Lote: precisao em |z| < 87 (ref. long double)", passed, details.str());
+    }
+
+    /**
+     * @brief TESTE 10: Observação única (broadcast) e tamanhos fora da largura do vetor.
+     */
+    void test_batch_broadcast() {
+        bool passed = true;
+        for(size_t n = 0; n <= 19; n++){
+            std::vector<double> d(n), r(n, 7.5), a(n), b(n);
+            for(size_t i = 0; i < n; i++){ d[i] = 7.49 + 0.001 * double(i); } // |z| < 2
+            FieldNoise::log_prob_r(d.data(), r.data(), a.data(), n);
+            FieldNoise::log_prob_r(d.data(), 7.5, b.data(), n);
+            for(size_t i = 0; i < n; i++){
+                passed = passed && a[i] == b[i] && is_approx(a[i], FieldNoise::log_prob_r(d[i], 7.5), 1e-9);
+            }
+        }
+        // Resultado no próprio vetor de entrada
+        std::vector<double> v(13, 1.0);
+        FieldNoise::log_prob_v(v.data(), 1.0, v.data(), v.size());
+        passed = passed && is_approx(v[12], FieldNoise::log_prob_v(1.0, 1.0), 1e-9);
+
+        print_result("Lote: observacao unica e sobras (n = 0..19)", passed);
+    }
+
+    // ============================================================================
+    // TESTES DO MODO TABELA
+    // ============================================================================
+
+    /**
+     * @brief TESTE 11: Erro do modo TABLE dentro do máximo documentado, em toda a faixa (tabela e fora dela).
+     * A referência são os núcleos exatos, já validados contra long double no TESTE 9.
+     */
+    void test_table_error_bound() {
+        using S = NormalKernels::ScalarLanes;
+        const double k_r = 1.0 / (FieldNoise::SIGMA_R * std::sqrt(2.0));
+        const double k_h = 1.0 / (FieldNoise::SIGMA_H * std::sqrt(2.0));
+        const double k_v = 1.0 / (FieldNoise::SIGMA_V * std::sqrt(2.0));
+        const double w = FieldNoise::ROUNDING;
+
+        std::mt19937_64 rng(13);
+        std::uniform_real_distribution<double> unit(-1.0, 1.0);
+        FieldNoise::set_mode(FieldNoise::Mode::TABLE);
+
+        // Erro absoluto até |ln P| = 1, relativo além (as caudas chegam a |ln P| ~ 1e6)
+        auto error = [](double table, double exact){ return std::fabs(table - exact) / std::max(1.0, std::fabs(exact)); };
+        const double offsets[3] = {0.6, 15.0, 400.0}; // Perto da média, até o fim das tabelas próximas e além das distantes
+        const double spreads[3] = {0.005, 0.12, 0.9};
+
+        double worst_h = 0.0, worst_v = 0.0, worst_r = 0.0;
+        for(size_t i = 0; i < 300000; i++){
+            double truth = 90.0 * unit(rng);
+            double offset = offsets[i % 3] * unit(rng);
+            worst_h = std::max(worst_h, error(FieldNoise::log_prob_h(truth, truth + offset),
+                NormalKernels::log_interval_prob<S>((offset - w) * k_h, (offset + w) * k_h)));
+            worst_v = std::max(worst_v, error(FieldNoise::log_prob_v(truth, truth + offset),
+                NormalKernels::log_interval_prob<S>((offset - w) * k_v, (offset + w) * k_v)));
+
+            double d = 0.2 + 49.8 * std::fabs(unit(rng));
+            double r = d * (1.0 + spreads[i % 3] * unit(rng));
+            worst_r = std::max(worst_r, error(FieldNoise::log_prob_r(d, r),
+                NormalKernels::log_interval_prob<S>(100.0 * ((r - w) / d - 1) * k_r, 100.0 * ((r + w) / d - 1) * k_r)));
+        }
+        FieldNoise::set_mode(FieldNoise::Mode::EXACT);
+
+        std::ostringstream details;
+        details << "h " << worst_h << ", v " << worst_v << ", r " << worst_r;
+        bool passed = worst_h < FieldNoise::TABLE_MAX_ERROR_ANGLE && worst_v < FieldNoise::TABLE_MAX_ERROR_ANGLE
+                   && worst_r < FieldNoise::TABLE_MAX_ERROR_R;
+        print_result("Tabela: erro maximo documentado", passed, details.str());
+    }
+
+    /**
+     * @brief TESTE 12: O modo é de fato trocado, e os dois concordam perto da média.
+     */
+    void test_table_switch() {
+        double exact = FieldNoise::log_prob_h(10.0, 10.2);
+        FieldNoise::set_mode(FieldNoise::Mode::TABLE);
+        bool in_table = FieldNoise::mode() == FieldNoise::Mode::TABLE;
+        double table = FieldNoise::log_prob_h(10.0, 10.2);
+        double table_r = FieldNoise::log_prob_r(5.0, 5.01);
+        FieldNoise::set_mode(FieldNoise::Mode::EXACT);
+
+        bool passed = in_table && FieldNoise::mode() == FieldNoise::Mode::EXACT
+                   && exact != table && is_approx(exact, table, 1e-9)
+                   && is_approx(table_r, FieldNoise::log_prob_r(5.0, 5.01), 1e-8);
+        print_result("Tabela: troca de modo EXACT <-> TABLE", passed);
+    }
+
     void execute_testes() {
         std::cout << "=== Bateria de Testes Matematicos Probabilisticos ===" << std::endl;
         std::cout << "--- Nucleo Gaussiano ---" << std::endl;
@@ -167,6 +333,15 @@ public:
         test_r_maximum_likelihood();
         test_r_distance_decay();
         test_r_relative_consistency();
+
+        std::cout << "\n--- API em lote (" << FieldNoise::BATCH_BACKEND << ") ---" << std::endl;
+        test_batch_matches_scalar();
+        test_batch_full_range();
+        test_batch_broadcast();
+
+        std::cout << "\n--- Modo tabela ---" << std::endl;
+        test_table_error_bound();
+        test_table_switch();
         std::cout << "=====================================================" << std::endl;
     }
 };
@@ -0,0 +1,217 @@
+#pragma once
+
+#define True true
+#define False false
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @class FieldDistance
+ * @brief Transformada de distância das linhas do campo: distância de cada ponto do chão à linha mais próxima.
+ * @details
+ * Grade regular de CELL metros cobrindo o campo e uma margem de MARGIN metros, com a distância em
+ * milímetros (uint16_t, ~650 KB). É calculada uma única vez, de forma exata (segmentos e círculo central),
+ * e pode ser gravada em arquivo: `shared()` mapeia DEFAULT_FILE se ele existir e corresponder a esta
+ * geometria (`make field_distance` nesta pasta o gera), senão a constrói na memória (~70 ms).
+ *
+ * A consulta interpola bilinearmente os 4 nós vizinhos e devolve também o gradiente, usado pela
+ * descida da localização por linhas; o erro é de até meio passo (2.5 cm), junto às próprias linhas.
+ * Depois de pronta, é apenas lida: pode ser consultada por várias threads.
+ *
+ * As linhas são simétricas por rotação de 180° em torno do centro: a grade vale para os dois lados.
+ */
+class FieldDistance {
+public:
+    // Geometria do campo (m), a mesma de Localization::list_landmark
+    static constexpr double HALF_LENGTH = 15.0;
+    static constexpr double HALF_WIDTH = 10.0;
+    static constexpr double PENALTY_DEPTH = 1.8;       ///< Profundidade da grande área
+    static constexpr double PENALTY_HALF_WIDTH = 3.0;  ///< Meia largura da grande área
+    static constexpr double CIRCLE_RADIUS = 2.0;       ///< Círculo central
+
+    static constexpr double CELL = 0.05;    ///< Passo da grade (m)
+    static constexpr double MARGIN = 2.0;   ///< Área coberta além das linhas externas (m)
+    static constexpr size_t COLUMNS = size_t(2.0 * (HALF_LENGTH + MARGIN) / CELL + 0.5) + 1;  ///< Ao longo de x
+    static constexpr size_t ROWS = size_t(2.0 * (HALF_WIDTH + MARGIN) / CELL + 0.5) + 1;      ///< Ao longo de y
+
+    static constexpr const char* DEFAULT_FILE = "field_distance.bin";
+
+private:
+    /**
+     * @struct Header
+     * @brief Início do arquivo: identifica o formato e a geometria com que a grade foi gerada.
+     */
+    struct Header {
+        char magic[8];
+        uint32_t columns;
+        uint32_t rows;
+        double geometry[7];
+    };
+
+    static constexpr char MAGIC[8] = {'R', 'I', 'M', 'E', 'F', 'D', 'T', '1'};
+
+    static Header __expected_header() {
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.columns = uint32_t(COLUMNS);
+        header.rows = uint32_t(ROWS);
+        double geometry[7] = {HALF_LENGTH, HALF_WIDTH, PENALTY_DEPTH, PENALTY_HALF_WIDTH, CIRCLE_RADIUS, CELL, MARGIN};
+        std::memcpy(header.geometry, geometry, sizeof(geometry));
+        return header;
+    }
+
+    const uint16_t* __cells = nullptr;   ///< ROWS x COLUMNS, linha a linha (mm)
+    std::vector<uint16_t> __built;       ///< Dono dos dados quando construída na memória
+    void* __map = nullptr;
+    size_t __map_size = 0;
+
+    ///< Distância de (x, y) ao segmento a-b
+    static double __segment(double x, double y, double ax, double ay, double bx, double by) {
+        double vx = bx - ax, vy = by - ay;
+        double s = std::clamp(((x - ax) * vx + (y - ay) * vy) / (vx * vx + vy * vy), 0.0, 1.0);
+        return std::hypot(x - ax - s * vx, y - ay - s * vy);
+    }
+
+    ///< Distância exata de (x, y) à linha mais próxima do campo
+    static double __exact(double x, double y) {
+        const double L = HALF_LENGTH, W = HALF_WIDTH, P = L - PENALTY_DEPTH, A = PENALTY_HALF_WIDTH;
+        static constexpr size_t SEGMENTS = 11;
+        const double segments[SEGMENTS][4] = {
+            {-L, -W, +L, -W}, {-L, +W, +L, +W},   // Laterais
+            {-L, -W, -L, +W}, {+L, -W, +L, +W},   // Linhas de fundo
+            {0.0, -W, 0.0, +W},                   // Meio de campo
+            {-P, -A, -P, +A}, {-L, -A, -P, -A}, {-L, +A, -P, +A},  // Grande área esquerda
+            {+P, -A, +P, +A}, {+P, -A, +L, -A}, {+P, +A, +L, +A}   // Grande área direita
+        };
+        double best = std::fabs(std::hypot(x, y) - CIRCLE_RADIUS);
+        for(const auto& s : segments){ best = std::min(best, __segment(x, y, s[0], s[1], s[2], s[3])); }
+        return best;
+    }
+
+public:
+    FieldDistance() = default;
+    FieldDistance(const FieldDistance&) = delete;
+    void operator=(const FieldDistance&) = delete;
+
+    ~FieldDistance() {
+        if(this->__map != nullptr){ munmap(this->__map, this->__map_size); }
+    }
+
+    /**
+     * @brief Grade compartilhada do processo: mapeada de DEFAULT_FILE, ou construída se o arquivo não servir.
+     */
+    static const FieldDistance& shared() {
+        static FieldDistance instance;
+        static const bool ready = [](){
+            if(!instance.load(DEFAULT_FILE)){ instance.build(); }
+            return True;
+        }();
+        (void)ready;
+        return instance;
+    }
+
+    /**
+     * @brief Calcula a grade na memória.
+     */
+    void build() {
+        this->__built.resize(ROWS * COLUMNS);
+        for(size_t row = 0; row < ROWS; row++){
+            double y = -(HALF_WIDTH + MARGIN) + double(row) * CELL;
+            for(size_t column = 0; column < COLUMNS; column++){
+                double x = -(HALF_LENGTH + MARGIN) + double(column) * CELL;
+                double mm = std::round(__exact(x, y) * 1000.0);
+                this->__built[row * COLUMNS + column] = uint16_t(std::min(mm, 65535.0));
+            }
+        }
+        this->__cells = this->__built.data();
+    }
+
+    /**
+     * @brief Mapeia uma grade gravada por save(), somente leitura.
+     * @return False se o arquivo não existir, estiver truncado ou for de outra geometria (a grade atual é mantida).
+     */
+    bool load(const char* path) {
+        int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if(fd < 0){ return False; }
+
+        size_t size = sizeof(Header) + ROWS * COLUMNS * sizeof(uint16_t);
+        struct stat st;
+        if(fstat(fd, &st) != 0 || size_t(st.st_size) != size){ ::close(fd); return False; }
+
+        void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // O mapeamento continua válido sem o descritor
+        if(map == MAP_FAILED){ return False; }
+
+        Header expected = __expected_header();
+        if(std::memcmp(map, &expected, sizeof(Header)) != 0){ munmap(map, size); return False; }
+
+        if(this->__map != nullptr){ munmap(this->__map, this->__map_size); }
+        this->__map = map;
+        this->__map_size = size;
+        this->__cells = reinterpret_cast<const uint16_t*>(static_cast<const char*>(map) + sizeof(Header));
+        this->__built.clear();
+        this->__built.shrink_to_fit();
+        return True;
+    }
+
+    /**
+     * @brief Grava a grade (cabeçalho e nós) para ser mapeada por load().
+     */
+    bool save(const char* path) const {
+        if(this->__cells == nullptr){ return False; }
+        FILE* file = std::fopen(path, "wb");
+        if(file == nullptr){ return False; }
+        Header header = __expected_header();
+        bool ok = std::fwrite(&header, sizeof(Header), 1, file) == 1
+               && std::fwrite(this->__cells, sizeof(uint16_t), ROWS * COLUMNS, file) == ROWS * COLUMNS;
+        return (std::fclose(file) == 0) && ok;
+    }
+
+    /**
+     * @brief Indica se a grade veio de um arquivo mapeado (e não da construção na memória).
+     */
+    bool is_mapped() const { return this->__map != nullptr; }
+
+    /**
+     * @brief Bytes dos nós da grade.
+     */
+    static constexpr size_t bytes() { return ROWS * COLUMNS * sizeof(uint16_t); }
+
+    /**
+     * @brief Distância (m) de (x, y) à linha mais próxima, interpolada, e seu gradiente.
+     * @details Fora da grade, usa o ponto mais próximo da borda (longe de qualquer linha, de todo modo).
+     */
+    double operator()(double x, double y, double& dx, double& dy) const {
+        // fmax/fmin (e não std::clamp): um NaN vai para a borda em vez de virar um índice inválido
+        double u = std::fmin(std::fmax((x + HALF_LENGTH + MARGIN) * (1.0 / CELL), 0.0), double(COLUMNS - 1) - 1e-9);
+        double v = std::fmin(std::fmax((y + HALF_WIDTH + MARGIN) * (1.0 / CELL), 0.0), double(ROWS - 1) - 1e-9);
+        size_t i = size_t(u), j = size_t(v);
+        double fu = u - double(i), fv = v - double(j);
+
+        const uint16_t* p = this->__cells + j * COLUMNS + i;
+        double d00 = p[0], d10 = p[1], d01 = p[COLUMNS], d11 = p[COLUMNS + 1];
+        double bottom = d00 + fu * (d10 - d00), top = d01 + fu * (d11 - d01);
+
+        constexpr double SCALE = 0.001 / CELL; // mm por célula -> m por m
+        dx = ((d10 - d00) * (1.0 - fv) + (d11 - d01) * fv) * SCALE;
+        dy = (top - bottom) * SCALE;
+        return (bottom + fv * (top - bottom)) * 0.001;
+    }
+
+    /**
+     * @brief Distância exata, sem a grade (referência para medir o erro da interpolação).
+     */
+    static double exact(double x, double y) { return __exact(x, y); }
+};
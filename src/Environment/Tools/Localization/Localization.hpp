@@ -3,19 +3,58 @@
 #define True true
 #define False false
 
+#include "../FieldNoise/FieldNoise.hpp"
+#include "FieldDistance.hpp"
+
 #include <array>
 #include <vector>
 #include <string_view>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 
 /**
  * @brief Responsável por representar e agrupar as instâncias
  * auxiliares de localização e fornecer a lógica.
+ * @details
+ * A pose estimada é a da câmera (cabeça), em 6 graus de liberdade: posição no campo e
+ * orientação R = Rz(guinada) Ry(arfagem) Rx(rolagem), com arfagem positiva inclinando a câmera para baixo.
+ *
+ * localize() resolve, por mínimos quadrados, a pose que melhor explica as coordenadas polares dos
+ * marcos vistos no ciclo:
+ *   1. inicialização fechada supondo rolagem nula (o pescoço só tem guinada e arfagem) e a altura
+ *      típica da câmera;
+ *   2. algumas iterações de Gauss-Newton sobre todos os marcos, cada medida pesada pelo desvio do
+ *      modelo de ruído do servidor (FieldNoise) somado ao do arredondamento.
+ * Informações fracas a priori (rolagem nula e altura de robô em pé) tornam o problema bem posto com
+ * apenas 2 marcos, inclusive vistos lado a lado, e são desprezíveis diante das medidas quando há 3 ou mais.
+ *
+ * Com menos de 2 marcos (a maior parte dos ciclos no meio do campo), a pose anterior é acompanhada
+ * pelas linhas vistas: o chão é ajustado aos pontos das linhas (inclinação e altura da câmera) e a pose
+ * no plano desce o gradiente da transformada de distância das linhas do campo (FieldDistance), a partir
+ * de poucas hipóteses de guinada em torno da pose anterior.
+ *
+ * Não aloca (até 8 marcos e MAX_LINES linhas, matrizes na pilha) e tem custo limitado: no máximo
+ * MAX_ITERATIONS iterações pelos marcos, escolhidas para que 8 marcos caibam em BUDGET_US, e no máximo
+ * LINE_POINTS pontos das linhas, com um número fixo de passos por hipótese (ver `make benchmark` nesta pasta).
+ *
+ * Visões sem nova pose mantêm a anterior, mas envelhecida: a confiança decai (CONFIDENCE_DECAY), o erro
+ * de posição cresce (DRIFT_PER_VISION) e `visions_since_fix` conta as visões desde a última pose.
  */
 class Localization {
 public:
 
     // -- Atributos Inerentes à Localização Pensada pelo Robô
-    std::array<float, 3> my_position = {99, 99, 99};
+    std::array<float, 3> my_position = {99, 99, 99};  ///< Câmera no campo (m), do ponto de vista do nosso lado
+    std::array<float, 3> my_orientation = {0, 0, 0};  ///< (guinada, arfagem, rolagem) da câmera (graus)
+    float confidence = 0;        ///< Em [0, 1]: verossimilhança média por medida, relativa a um ajuste perfeito
+    float position_error = 99;   ///< Desvio padrão estimado da posição (m)
+    uint32_t visions_since_fix = 0;  ///< Visões seguidas sem nova pose (0: a pose é desta visão)
+
+    static constexpr size_t MAX_ITERATIONS = 8;
+    static constexpr double BUDGET_US = 20.0;  ///< Orçamento por agente por ciclo (µs)
+    static constexpr float CONFIDENCE_DECAY = 0.7f;   ///< Fator da confiança a cada visão sem nova pose
+    static constexpr float DRIFT_PER_VISION = 0.05f;  ///< Erro acrescido por visão sem nova pose (m): ~0.8 m/s por 60 ms
 
     struct Landmark {
     public:
@@ -46,7 +85,17 @@ public:
         {"G1R", +15.0f, +1.05f, 0.8f}
     }};
 
-    std::vector<Landmark*> visibles_landmarks;
+    std::vector<Landmark*> visibles_landmarks; ///< Marcos da última visão (esvaziado em begin_vision)
+
+    static constexpr size_t MAX_LINES = 16;  ///< Segmentos de linha guardados por visão
+
+    struct Line {
+        float start[3];  ///< Polar (distância, horizontal, vertical) de uma ponta, como lida do servidor
+        float end[3];
+    };
+
+    std::array<Line, MAX_LINES> visible_lines{};  ///< Linhas da última visão
+    size_t line_count = 0;
 
     // - Métodos Inerentes à Localização
 
@@ -54,66 +103,717 @@ public:
        // Possíveis atributos que eu possa considerar
     ) {
       visibles_landmarks.reserve(8); // Assim evitamos construções inúteis.
+      FieldDistance::shared();       // A grade fica pronta antes do primeiro ciclo
     }
 
     // -- Funções de Atualização de Itens Visuais
 
+    /**
+     * @brief Início de uma nova visão: os marcos e linhas vistos antes deixam de valer.
+     */
+    void
+    begin_vision(){
+        visibles_landmarks.clear();
+        line_count = 0;
+        __reference = __pose;
+    }
+
     bool
     update_visible_landmark(
-       std::string_view tag_lm,
-       float values_from_shp_position[3]
+       std::size_t index,
+       const float values_from_shp_position[3]
     ){
-        // Temos garantia que visible_landmarks está vazio e podemos inserir e modificar
+        if(index >= list_landmark.size()){ return False; }
 
-        // Devemos iterar sobre os poucos elementos e inserir os valores correspondente
         for(
-            int i = 0;
-                i < 8;
+            int j = 0;
+                j < 3;
+                j++
+        ){
+            list_landmark[index].sph_position[j] = values_from_shp_position[j];
+        }
+
+        // Um marco repetido na mesma visão apenas atualiza a leitura (e o vetor nunca passa de 8)
+        for(Landmark* seen : visibles_landmarks){
+            if(seen == &list_landmark[index]){ return True; }
+        }
+        visibles_landmarks.push_back( &list_landmark[index] );
+        return True;
+    }
+
+    bool
+    update_visible_landmark(
+       std::string_view tag_lm,
+       const float values_from_shp_position[3]
+    ){
+        // Devemos iterar sobre os poucos elementos e encontrar o correspondente
+        for(
+            std::size_t i = 0;
+                i < list_landmark.size();
                 i++
         ){
 
             if(
-                tag_lm == list_landmark[i].tag
+                tag_lm == std::string_view(list_landmark[i].tag, 3)
             ){
-
-                // Então temos um novo landmark visivel.
-                for(
-                    int j = 0;
-                        j < 3;
-                        j++
-                ){
-                    // Dependendo de qual lado estamos, também devemos fazer alterações
-
-                    list_landmark[i].sph_position[j] = values_from_shp_position[j];
-                }
-
-                visibles_landmarks.push_back( &list_landmark[i] );
-                return True;
+                return update_visible_landmark(i, values_from_shp_position);
             }
         }
 
         return False;
     }
 
+    /**
+     * @brief Guarda um segmento de linha visto (pontas em polar, como lidas).
+     * @return False se já há MAX_LINES linhas nesta visão.
+     */
+    bool
+    update_visible_line(
+       const float start[3],
+       const float end[3]
+    ){
+        if(line_count >= MAX_LINES){ return False; }
+
+        for(
+            int j = 0;
+                j < 3;
+                j++
+        ){
+            visible_lines[line_count].start[j] = start[j];
+            visible_lines[line_count].end[j] = end[j];
+        }
+        line_count++;
+        return True;
+    }
+
+    /**
+     * @brief Estima a pose da câmera a partir da última visão.
+     * @param is_left Lado do nosso time: do lado direito, as posições dos marcos são espelhadas
+     * (x, y) -> (-x, -y), de modo que nosso gol fique sempre em x negativo.
+     * @return False sem marcos nem linhas suficientes, ou sem convergência numérica: a pose anterior é mantida,
+     * com a confiança reduzida e o erro de posição aumentado.
+     * @details Com 2 ou mais marcos, a pose é absoluta; senão, as linhas só acompanham uma pose já obtida
+     * (as linhas do campo são simétricas, não dizem sozinhas de que lado estamos).
+     * Deve ser chamada uma vez por visão: cada falha envelhece a pose publicada.
+     */
     bool
-    localize(){
-        // Implementaremos a lógica de posição aqui.
+    localize(bool is_left = True){
         // Temos garantia que utilizaremos essa função logo após o parsing da mensagem
 
-        if(visibles_landmarks.size() < 2){
-            return False;
+        if(visibles_landmarks.size() >= 2 && __localize_landmarks(is_left)){
+            return True;
         }
+        if(__localize_lines()){ return True; }
+
+        __coast();
+        return False;
+    }
 
+private:
 
+    using Vec3 = std::array<double, 3>;
+    using Vec6 = std::array<double, 6>;
+    using Mat3 = std::array<Vec3, 3>;
 
+    static constexpr double DEG = 3.14159265358979323846 / 180.0;
+    static constexpr double ROLL_PRIOR = 10.0 * DEG;  ///< Desvio a priori da rolagem da câmera (rad)
+    static constexpr double CAMERA_HEIGHT = 0.5;      ///< Altura típica da câmera com o robô em pé (m)
+    static constexpr double HEIGHT_PRIOR = 0.2;       ///< Desvio a priori dessa altura (m)
 
+    // -- Linhas
+    static constexpr size_t LINE_SAMPLES = 2;          ///< Pontos por segmento: as pontas
+    static constexpr size_t LINE_POINTS = 20;          ///< Pontos usados por visão (de linhas espaçadas na ordem da visão): limita o custo das hipóteses
+    static constexpr size_t LINE_ITERATIONS = 4;       ///< Passos de descida por hipótese
+    static constexpr double LINE_FLOOR = 0.05;         ///< Desvio mínimo de um ponto: largura da linha, círculo em segmentos (m)
+    static constexpr double LINE_OUTLIER = 0.5;        ///< Pontos mais longe que isso de qualquer linha não puxam a pose (m)
+    static constexpr double LINE_REACH = 4.0;          ///< Raio de LINE_OUTLIER na primeira iteração, reduzido à metade a cada uma (m)
+    static constexpr double TILT_PRIOR = 10.0 * DEG;   ///< Desvio da inclinação da câmera em relação à pose anterior
+    static constexpr double POSITION_PRIOR = 1.0;      ///< Desvio da posição em relação à pose anterior (m)
+    static constexpr double YAW_PRIOR = 30.0 * DEG;    ///< Desvio da guinada em relação à pose anterior
+    static constexpr double MAX_STEP = 0.5;            ///< Maior passo de uma iteração (m ou rad)
+    static constexpr double MIN_LINE_CONFIDENCE = 0.3; ///< Abaixo disso, a pose pelas linhas é descartada
+    static constexpr double LINE_ACCEPT = 0.8;         ///< Confiança que dispensa as demais hipóteses
+    static constexpr std::array<double, 3> YAW_HYPOTHESES = {0.0, -20.0 * DEG, +20.0 * DEG}; ///< Em torno da guinada anterior
 
+    /**
+     * @struct Pose
+     * @brief Câmera no campo: p_campo = R p_câmera + t.
+     */
+    struct Pose {
+        Mat3 R{};
+        Vec3 t{};
 
-        visibles_landmarks.clear();
+        Vec3 to_camera(const Vec3& world) const {
+            Vec3 d = {world[0] - t[0], world[1] - t[1], world[2] - t[2]};
+            return {
+                R[0][0] * d[0] + R[1][0] * d[1] + R[2][0] * d[2],
+                R[0][1] * d[0] + R[1][1] * d[1] + R[2][1] * d[2],
+                R[0][2] * d[0] + R[1][2] * d[1] + R[2][2] * d[2]
+            };
+        }
+
+        /**
+         * @brief t += step[0..2] (campo); R = R exp([step[3..5]]x) (rotação no referencial da câmera).
+         */
+        void apply(const Vec6& step) {
+            for(int i = 0; i < 3; i++){ t[i] += step[i]; }
+
+            double wx = step[3], wy = step[4], wz = step[5];
+            double angle = std::sqrt(wx * wx + wy * wy + wz * wz);
+            double a = (angle < 1e-9) ? 1.0 : std::sin(angle) / angle;
+            double b = (angle < 1e-9) ? 0.5 : (1.0 - std::cos(angle)) / (angle * angle);
+            Mat3 W = {{{0.0, -wz, wy}, {wz, 0.0, -wx}, {-wy, wx, 0.0}}};
+            Mat3 E{};
+            for(int i = 0; i < 3; i++){
+                for(int j = 0; j < 3; j++){
+                    double W2 = W[i][0] * W[0][j] + W[i][1] * W[1][j] + W[i][2] * W[2][j];
+                    E[i][j] = (i == j ? 1.0 : 0.0) + a * W[i][j] + b * W2;
+                }
+            }
+            Mat3 previous = R;
+            for(int i = 0; i < 3; i++){
+                for(int j = 0; j < 3; j++){
+                    R[i][j] = previous[i][0] * E[0][j] + previous[i][1] * E[1][j] + previous[i][2] * E[2][j];
+                }
+            }
+        }
+
+        ///< R = Rz(yaw) Ry(pitch)
+        void set_rotation(double yaw, double pitch) {
+            double cy = std::cos(yaw), sy = std::sin(yaw), cp = std::cos(pitch), sp = std::sin(pitch);
+            R = {{{cy * cp, -sy, cy * sp}, {sy * cp, cy, sy * sp}, {-sp, 0.0, cp}}};
+        }
+
+        std::array<float, 3> angles() const {
+            return {
+                float(std::atan2(R[1][0], R[0][0]) / DEG),
+                float(std::asin(std::fmax(-1.0, std::fmin(1.0, -R[2][0]))) / DEG),
+                float(std::atan2(R[2][1], R[2][2]) / DEG)
+            };
+        }
+    };
+
+    /**
+     * @brief (distância, horizontal, vertical) em (m, rad, rad) de um ponto no referencial da câmera.
+     */
+    static Vec3 polar(const Vec3& p) {
+        double planar = std::sqrt(p[0] * p[0] + p[1] * p[1]);
+        return {std::sqrt(planar * planar + p[2] * p[2]), std::atan2(p[1], p[0]), std::atan2(p[2], planar)};
+    }
+
+    /**
+     * @brief Ponto no referencial da câmera a partir de (distância, horizontal, vertical) em (m, rad, rad).
+     */
+    static Vec3 cartesian(const Vec3& polar) {
+        double planar = polar[0] * std::cos(polar[2]);
+        return {planar * std::cos(polar[1]), planar * std::sin(polar[1]), polar[0] * std::sin(polar[2])};
+    }
+
+    static double dot(const Vec3& a, const Vec3& b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+    static Vec3 cross(const Vec3& a, const Vec3& b) {
+        return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+    }
+
+    ///< Ângulo em (-pi, pi]
+    static double wrap(double angle) {
+        return angle - 2.0 * 3.14159265358979323846 * std::round(angle / (2.0 * 3.14159265358979323846));
     }
 
+    /**
+     * @struct Normal
+     * @brief Equações normais H step = g do Gauss-Newton (N x N), com fatoração de Cholesky.
+     * @tparam N 6 para a pose completa (marcos), 3 para o chão e a pose no plano (linhas).
+     */
+    template<size_t N>
+    struct Normal {
+        using Vec = std::array<double, N>;
+
+        std::array<Vec, N> H{};
+        Vec g{};
+        std::array<Vec, N> L{};
+
+        void clear() { H = {}; g = {}; }
 
+        ///< Soma a linha J (já dividida pelo desvio) com resíduo e
+        void add(const Vec& J, double e) {
+            for(size_t i = 0; i < N; i++){
+                if(J[i] == 0.0){ continue; }
+                g[i] += J[i] * e;
+                for(size_t j = 0; j <= i; j++){ H[i][j] += J[i] * J[j]; }
+            }
+        }
+
+        bool factor() {
+            for(size_t i = 0; i < N; i++){
+                for(size_t j = 0; j <= i; j++){
+                    double sum = H[i][j];
+                    for(size_t k = 0; k < j; k++){ sum -= L[i][k] * L[j][k]; }
+                    if(i == j){
+                        if(!(sum > 1e-12)){ return False; }
+                        L[i][i] = std::sqrt(sum);
+                    }
+                    else { L[i][j] = sum / L[j][j]; }
+                }
+            }
+            return True;
+        }
+
+        ///< x = H^{-1} b, após factor()
+        Vec solve_factored(Vec b) const {
+            for(size_t i = 0; i < N; i++){
+                for(size_t k = 0; k < i; k++){ b[i] -= L[i][k] * b[k]; }
+                b[i] /= L[i][i];
+            }
+            for(size_t i = N; i-- > 0;){
+                for(size_t k = i + 1; k < N; k++){ b[i] -= L[k][i] * b[k]; }
+                b[i] /= L[i][i];
+            }
+            return b;
+        }
 
+        bool solve(Vec& step) {
+            if(!this->factor()){ return False; }
+            step = this->solve_factored(g);
+            return True;
+        }
+
+        ///< Soma das variâncias das `k` primeiras variáveis: traço do bloco k x k de H^{-1}, após factor()
+        double inverse_trace(size_t k) const {
+            double trace = 0.0;
+            for(size_t i = 0; i < k; i++){
+                Vec unit{};
+                unit[i] = 1.0;
+                trace += this->solve_factored(unit)[i];
+            }
+            return trace;
+        }
+    };
+
+    /**
+     * @struct Problem
+     * @brief Observações de um ciclo: posição de cada marco no campo e sua leitura polar.
+     */
+    struct Problem {
+        size_t count = 0;
+        std::array<Vec3, 8> world{};
+        std::array<Vec3, 8> observed{};  ///< (m, rad, rad)
+        std::array<Vec3, 8> sigma{};     ///< Desvio de cada medida, nas mesmas unidades
+
+        Problem(const std::vector<Landmark*>& visibles, bool is_left) {
+            // Variância do arredondamento a 2 casas (uniforme em ±ROUNDING) somada à do ruído gaussiano
+            const double rounding = FieldNoise::ROUNDING * FieldNoise::ROUNDING / 3.0;
+            const double sigma_h = std::sqrt(FieldNoise::SIGMA_H * FieldNoise::SIGMA_H + rounding) * DEG;
+            const double sigma_v = std::sqrt(FieldNoise::SIGMA_V * FieldNoise::SIGMA_V + rounding) * DEG;
+
+            for(const Landmark* landmark : visibles){
+                if(count == world.size()){ break; }
+                double side = is_left ? 1.0 : -1.0;
+                double r = landmark->sph_position[0];
+                world[count] = {side * landmark->fixed_position[0], side * landmark->fixed_position[1], landmark->fixed_position[2]};
+                observed[count] = {r, landmark->sph_position[1] * DEG, landmark->sph_position[2] * DEG};
+                double sigma_r = FieldNoise::SIGMA_R / 100.0 * r;
+                sigma[count] = {std::sqrt(sigma_r * sigma_r + rounding), sigma_h, sigma_v};
+                count++;
+            }
+        }
 
+        /**
+         * @brief Pose inicial com rolagem nula, por mínimos quadrados fechados sobre todos os marcos.
+         * @details Com R = Rz(yaw) Ry(pitch), a altura de um marco em relação à câmera não depende da guinada:
+         * L_z - CAMERA_HEIGHT = -sin(pitch) c_x + cos(pitch) c_z, resolvida para a arfagem em poucas iterações
+         * de Gauss-Newton em uma variável (sem a altura, pares de marcos vistos lado a lado não a determinam).
+         * Depois, a guinada é a rotação 2D que melhor alinha as projeções horizontais (Procrustes) e t a média de L - R c.
+         */
+        bool initial_pose(Pose& pose) const {
+            std::array<Vec3, 8> camera{};
+            for(size_t i = 0; i < count; i++){ camera[i] = cartesian(observed[i]); }
+
+            double pitch = 0.0;
+            for(int iteration = 0; iteration < 4; iteration++){
+                double c = std::cos(pitch), s = std::sin(pitch), num = 0.0, den = 0.0;
+                for(size_t i = 0; i < count; i++){
+                    double e = world[i][2] - CAMERA_HEIGHT + s * camera[i][0] - c * camera[i][2];
+                    double J = c * camera[i][0] + s * camera[i][2];
+                    num += J * e;
+                    den += J * J;
+                }
+                if(den < 1e-12){ break; }
+                pitch = std::fmax(-1.5, std::fmin(1.5, pitch - num / den));
+            }
+
+            // Centros das projeções horizontais, na câmera nivelada e no campo
+            double c = std::cos(pitch), s = std::sin(pitch);
+            std::array<std::array<double, 2>, 8> level{};
+            double qx = 0.0, qy = 0.0, wx = 0.0, wy = 0.0;
+            for(size_t i = 0; i < count; i++){
+                level[i] = {c * camera[i][0] + s * camera[i][2], camera[i][1]};
+                qx += level[i][0]; qy += level[i][1];
+                wx += world[i][0]; wy += world[i][1];
+            }
+            qx /= double(count); qy /= double(count); wx /= double(count); wy /= double(count);
+            double cross = 0.0, dot = 0.0;
+            for(size_t i = 0; i < count; i++){
+                double ax = level[i][0] - qx, ay = level[i][1] - qy, bx = world[i][0] - wx, by = world[i][1] - wy;
+                cross += ax * by - ay * bx;
+                dot += ax * bx + ay * by;
+            }
+            double yaw = std::atan2(cross, dot);
+            if(!std::isfinite(yaw) || !std::isfinite(pitch)){ return False; }
+            pose.set_rotation(yaw, pitch);
+
+            pose.t = {0.0, 0.0, 0.0};
+            for(size_t i = 0; i < count; i++){
+                for(int k = 0; k < 3; k++){
+                    double rotated = pose.R[k][0] * camera[i][0] + pose.R[k][1] * camera[i][1] + pose.R[k][2] * camera[i][2];
+                    pose.t[k] += (world[i][k] - rotated) / double(count);
+                }
+            }
+            return True;
+        }
+
+        /**
+         * @brief Equações normais de todas as medidas (e das informações a priori) em torno de `pose`.
+         * @details Com p = R^T (L - t): dp/dt = -R^T e, para R <- R exp([w]x), dp/dw = [p]x.
+         */
+        void linearize(const Pose& pose, Normal<6>& normal) const {
+            normal.clear();
+            for(size_t i = 0; i < count; i++){
+                Vec3 p = pose.to_camera(world[i]);
+                double planar2 = p[0] * p[0] + p[1] * p[1];
+                double planar = std::sqrt(planar2);
+                double r2 = planar2 + p[2] * p[2];
+                double r = std::sqrt(r2);
+                if(planar < 1e-9){ continue; } // Marco sobre o eixo vertical da câmera: horizontal indefinido
+
+                // Derivadas de (distância, horizontal, vertical) em relação a p
+                Vec3 d_polar[3] = {
+                    {p[0] / r, p[1] / r, p[2] / r},
+                    {-p[1] / planar2, p[0] / planar2, 0.0},
+                    {-p[0] * p[2] / (planar * r2), -p[1] * p[2] / (planar * r2), planar / r2}
+                };
+                Vec3 predicted = {r, std::atan2(p[1], p[0]), std::atan2(p[2], planar)};
+
+                for(int m = 0; m < 3; m++){
+                    const Vec3& d = d_polar[m];
+                    Vec6 J;
+                    // Translação: -(d^T R^T) = -(R d)^T
+                    for(int k = 0; k < 3; k++){ J[k] = -(pose.R[k][0] * d[0] + pose.R[k][1] * d[1] + pose.R[k][2] * d[2]); }
+                    // Rotação: d^T [p]x = (d x p)^T
+                    J[3] = d[1] * p[2] - d[2] * p[1];
+                    J[4] = d[2] * p[0] - d[0] * p[2];
+                    J[5] = d[0] * p[1] - d[1] * p[0];
+
+                    double e = observed[i][m] - predicted[m];
+                    if(m == 1){ e = wrap(e); }
+                    double inverse = 1.0 / sigma[i][m];
+                    for(double& j : J){ j *= inverse; }
+                    normal.add(J, e * inverse);
+                }
+            }
+
+            // A priori: rolagem nula, sin(rolagem) ~ R[2][1], com d R[2][1] / dw = (R[2][2], 0, -R[2][0]); e a altura da câmera
+            Vec6 roll = {0.0, 0.0, 0.0, pose.R[2][2] / ROLL_PRIOR, 0.0, -pose.R[2][0] / ROLL_PRIOR};
+            normal.add(roll, -pose.R[2][1] / ROLL_PRIOR);
+            Vec6 height = {0.0, 0.0, 1.0 / HEIGHT_PRIOR, 0.0, 0.0, 0.0};
+            normal.add(height, (CAMERA_HEIGHT - pose.t[2]) / HEIGHT_PRIOR);
+
+            for(int i = 0; i < 6; i++){
+                for(int j = i + 1; j < 6; j++){ normal.H[i][j] = normal.H[j][i]; }
+            }
+        }
+
+        /**
+         * @brief exp da média, por medida, de ln P(leitura | pose) - ln P(leitura | leitura) pelo FieldNoise.
+         * @details ~0.6 a 1 com leituras coerentes entre si; cai rapidamente com um marco inconsistente.
+         * Usa as versões em lote de FieldNoise: uma chamada por grandeza para todos os marcos.
+         */
+        double confidence(const Pose& pose) const {
+            // predicted[m][i] e read[m][i]: grandeza m (distância, horizontal, vertical) do marco i, em m e graus
+            std::array<std::array<double, 8>, 3> predicted{}, read{};
+            for(size_t i = 0; i < count; i++){
+                Vec3 p = polar(pose.to_camera(world[i]));
+                read[0][i] = observed[i][0];
+                read[1][i] = observed[i][1] / DEG;
+                read[2][i] = observed[i][2] / DEG;
+                predicted[0][i] = p[0];
+                predicted[1][i] = read[1][i] - wrap(observed[i][1] - p[1]) / DEG;
+                predicted[2][i] = p[2] / DEG;
+            }
+
+            std::array<double, 8> fit{}, perfect{};
+            double sum = 0.0;
+            for(int m = 0; m < 3; m++){
+                if(m == 0){
+                    FieldNoise::log_prob_r(predicted[m].data(), read[m].data(), fit.data(), count);
+                    FieldNoise::log_prob_r(read[m].data(), read[m].data(), perfect.data(), count);
+                }
+                else if(m == 1){
+                    FieldNoise::log_prob_h(predicted[m].data(), read[m].data(), fit.data(), count);
+                    FieldNoise::log_prob_h(read[m].data(), read[m].data(), perfect.data(), count);
+                }
+                else {
+                    FieldNoise::log_prob_v(predicted[m].data(), read[m].data(), fit.data(), count);
+                    FieldNoise::log_prob_v(read[m].data(), read[m].data(), perfect.data(), count);
+                }
+                for(size_t i = 0; i < count; i++){ sum += fit[i] - perfect[i]; }
+            }
+            return std::exp(std::fmin(0.0, sum / double(3 * count)));
+        }
+    };
+
+
+    /**
+     * @struct LineProblem
+     * @brief Pontos amostrados das linhas de um ciclo, no referencial da câmera e no plano do chão.
+     */
+    struct LineProblem {
+        static constexpr size_t CAPACITY = LINE_POINTS;
+
+        size_t count = 0;
+        std::array<Vec3, CAPACITY> camera{};
+        std::array<double, CAPACITY> inverse_sigma{};
+        std::array<std::array<double, 2>, CAPACITY> level{};  ///< No chão, com x na direção da câmera (após ground)
+        Mat3 tilt{};                  ///< Linhas: direção da câmera no chão, lateral e vertical, no referencial da câmera
+        double height = CAMERA_HEIGHT;
+        double height_variance = HEIGHT_PRIOR * HEIGHT_PRIOR;
+
+        LineProblem(const std::array<Line, MAX_LINES>& lines, size_t line_count) {
+            // Desvio de um ponto a r metros: distância e ângulos do FieldNoise, com um mínimo de LINE_FLOOR
+            const double relative = std::sqrt(
+                FieldNoise::SIGMA_R * FieldNoise::SIGMA_R / 1e4
+                + (FieldNoise::SIGMA_H * FieldNoise::SIGMA_H + FieldNoise::SIGMA_V * FieldNoise::SIGMA_V) * DEG * DEG
+            );
+            // Com mais linhas que cabem em LINE_POINTS, ficam linhas espaçadas na ordem da visão
+            size_t used = std::min(line_count, MAX_LINES);
+            size_t keep = std::min(used, LINE_POINTS / LINE_SAMPLES);
+            for(size_t n = 0; n < keep; n++){
+                const Line& line = lines[n * used / keep];
+                Vec3 a = cartesian({line.start[0], line.start[1] * DEG, line.start[2] * DEG});
+                Vec3 b = cartesian({line.end[0], line.end[1] * DEG, line.end[2] * DEG});
+                for(size_t k = 0; k < LINE_SAMPLES; k++){
+                    double f = double(k) / double(LINE_SAMPLES - 1);
+                    Vec3 p = {a[0] + f * (b[0] - a[0]), a[1] + f * (b[1] - a[1]), a[2] + f * (b[2] - a[2])};
+                    double sigma = std::hypot(relative * std::sqrt(dot(p, p)), LINE_FLOOR);
+                    camera[count] = p;
+                    inverse_sigma[count] = 1.0 / sigma;
+                    count++;
+                }
+            }
+        }
+
+        /**
+         * @brief Plano do chão no referencial da câmera: vertical n e altura h, com n . p + h = 0 nas linhas.
+         * @details Gauss-Newton em (inclinação em duas direções, altura) partindo da pose anterior, que também
+         * entra como informação a priori: com uma só direção de linha, a inclinação em torno dela é a anterior.
+         * Depois, leva os pontos ao plano do chão (`level`).
+         * @return False se a câmera olha na vertical (sem direção no chão) ou sem convergência numérica.
+         */
+        bool ground(const Pose& reference) {
+            const Vec3 previous = {reference.R[2][0], reference.R[2][1], reference.R[2][2]};
+            Vec3 up = previous;
+            height = reference.t[2];
+
+            Normal<3> normal;
+            for(size_t iteration = 0; iteration < 3; iteration++){
+                // Base perpendicular a `up`, a partir do eixo lateral da câmera
+                Vec3 u = {-up[1] * up[0], 1.0 - up[1] * up[1], -up[1] * up[2]};
+                double norm = std::sqrt(dot(u, u));
+                if(norm < 1e-6){ return False; }
+                for(double& x : u){ x /= norm; }
+                Vec3 v = cross(up, u);
+
+                normal.clear();
+                for(size_t k = 0; k < count; k++){
+                    double w = inverse_sigma[k];
+                    normal.add({dot(u, camera[k]) * w, dot(v, camera[k]) * w, w}, -(dot(up, camera[k]) + height) * w);
+                }
+                normal.add({1.0 / TILT_PRIOR, 0.0, 0.0}, dot(u, previous) / TILT_PRIOR);
+                normal.add({0.0, 1.0 / TILT_PRIOR, 0.0}, dot(v, previous) / TILT_PRIOR);
+                normal.add({0.0, 0.0, 1.0 / HEIGHT_PRIOR}, (CAMERA_HEIGHT - height) / HEIGHT_PRIOR);
+
+                Vec3 step;
+                if(!normal.solve(step)){ return False; }
+                for(int i = 0; i < 3; i++){ up[i] += step[0] * u[i] + step[1] * v[i]; }
+                norm = std::sqrt(dot(up, up));
+                for(double& x : up){ x /= norm; }
+                height += step[2];
+            }
+            height_variance = normal.solve_factored({0.0, 0.0, 1.0})[2];
+
+            // Direção da câmera no chão: o eixo x da câmera sem a componente vertical
+            Vec3 forward = {1.0 - up[0] * up[0], -up[0] * up[1], -up[0] * up[2]};
+            double norm = std::sqrt(dot(forward, forward));
+            if(norm < 1e-6){ return False; }
+            for(double& x : forward){ x /= norm; }
+            tilt = {forward, cross(up, forward), up};
+
+            for(size_t k = 0; k < count; k++){
+                level[k] = {dot(tilt[0], camera[k]), dot(tilt[1], camera[k])};
+            }
+            return True;
+        }
+
+        /**
+         * @brief Como em Problem::confidence: exp da média de -(distância / desvio)^2 / 2, a parte gaussiana de ln P.
+         * @param fit Soma de (distância / desvio)^2 dos pontos (ver descend).
+         */
+        double confidence(double fit) const {
+            return std::exp(-fit / (2.0 * double(count)));
+        }
+
+        /**
+         * @brief Gauss-Newton de (x, y, guinada) sobre a distância às linhas, a partir de `planar`.
+         * @details O raio além do qual um ponto é ignorado começa em LINE_REACH e cai à metade a cada iteração
+         * até LINE_OUTLIER: alguns graus de guinada deslocam as linhas distantes em metros, e um raio curto
+         * desde o início deixaria esses pontos sem gradiente.
+         * @param prior Pose anterior no plano, informação a priori (POSITION_PRIOR, YAW_PRIOR).
+         * @param normal Equações normais no ponto final (para a covariância).
+         * @param fit Soma de (distância / desvio)^2 dos pontos no ponto final, truncada em LINE_OUTLIER.
+         * @return Custo total no ponto final (pontos e informação a priori).
+         */
+        double descend(Vec3& planar, const Vec3& prior, const FieldDistance& field, Normal<3>& normal, double& fit) const {
+            double reach = LINE_REACH;
+            for(size_t iteration = 0; ; iteration++){
+                double outlier = (iteration == LINE_ITERATIONS) ? LINE_OUTLIER : std::fmax(LINE_OUTLIER, reach);
+                reach *= 0.5;
+                normal.clear();
+                fit = 0.0;
+                double c = std::cos(planar[2]), s = std::sin(planar[2]);
+                for(size_t k = 0; k < count; k++){
+                    double rx = c * level[k][0] - s * level[k][1];
+                    double ry = s * level[k][0] + c * level[k][1];
+                    double dx, dy;
+                    double d = field(planar[0] + rx, planar[1] + ry, dx, dy);
+                    double w = inverse_sigma[k];
+                    if(d > outlier){ fit += outlier * outlier * w * w; continue; } // Sem gradiente: não puxa
+                    fit += d * d * w * w;
+                    normal.add({dx * w, dy * w, (dy * rx - dx * ry) * w}, -d * w);
+                }
+
+                Vec3 e = {
+                    (prior[0] - planar[0]) / POSITION_PRIOR,
+                    (prior[1] - planar[1]) / POSITION_PRIOR,
+                    wrap(prior[2] - planar[2]) / YAW_PRIOR
+                };
+                normal.add({1.0 / POSITION_PRIOR, 0.0, 0.0}, e[0]);
+                normal.add({0.0, 1.0 / POSITION_PRIOR, 0.0}, e[1]);
+                normal.add({0.0, 0.0, 1.0 / YAW_PRIOR}, e[2]);
+                if(iteration == LINE_ITERATIONS){ return fit + dot(e, e); }
+
+                Vec3 step;
+                if(!normal.solve(step)){ return INFINITY; }
+                double largest = std::fmax(std::fabs(step[0]), std::fmax(std::fabs(step[1]), std::fabs(step[2])));
+                double scale = (largest > MAX_STEP) ? MAX_STEP / largest : 1.0;
+                for(int i = 0; i < 3; i++){ planar[i] += scale * step[i]; }
+            }
+        }
+    };
+
+    /**
+     * @brief Pose pelos marcos: inicialização fechada e Gauss-Newton (ver Problem).
+     */
+    bool
+    __localize_landmarks(bool is_left){
+        Problem problem(visibles_landmarks, is_left);
+
+        Pose pose;
+        if(!problem.initial_pose(pose)){ return False; }
+
+        Normal<6> normal;
+        for(size_t iteration = 0; iteration < MAX_ITERATIONS; iteration++){
+            problem.linearize(pose, normal);
+            Vec6 step;
+            if(!normal.solve(step)){ return False; }
+            pose.apply(step);
+
+            double size = 0.0;
+            for(double s : step){ size += s * s; }
+            if(size < 1e-12){ break; }
+        }
+
+        problem.linearize(pose, normal); // Covariância e resíduos no ponto final
+        if(!normal.factor()){ return False; }
+
+        __publish(pose, normal.inverse_trace(3), problem.confidence(pose));
+        return True;
+    }
+
+    /**
+     * @brief Pose pelas linhas, acompanhando a pose anterior à visão.
+     * @details Ajusta o chão (LineProblem::ground) e, para cada hipótese de guinada, desce a transformada
+     * de distância em (x, y, guinada); fica a de menor custo. As hipóteses seguintes só são tentadas se a
+     * anterior não explicar as linhas (LINE_ACCEPT).
+     * Custo limitado: no máximo LINE_POINTS pontos e YAW_HYPOTHESES.size() * (LINE_ITERATIONS + 1)
+     * consultas à grade por ponto; a mesma visão dá sempre a mesma pose. Com a grade fora do cache, a chamada
+     * pode passar de BUDGET_US (ver a coluna "no orc." de `make benchmark`).
+     */
+    bool
+    __localize_lines(){
+        if(!__has_fix || line_count < 2){ return False; }
+
+        LineProblem problem(visible_lines, line_count);
+        if(!problem.ground(__reference)){ return False; }
+
+        const FieldDistance& field = FieldDistance::shared();
+        const Mat3& R = __reference.R;
+        Vec3 prior = {__reference.t[0], __reference.t[1], std::atan2(R[1][0], R[0][0])};
+
+        Vec3 best{};
+        Normal<3> best_normal;
+        double best_cost = INFINITY, best_fit = 0.0;
+        for(double offset : YAW_HYPOTHESES){
+            Vec3 planar = {prior[0], prior[1], prior[2] + offset};
+            Normal<3> normal;
+            double fit = 0.0;
+            double cost = problem.descend(planar, prior, field, normal, fit);
+            if(cost < best_cost){
+                best = planar;
+                best_normal = normal;
+                best_cost = cost;
+                best_fit = fit;
+            }
+            if(problem.confidence(best_fit) >= LINE_ACCEPT){ break; }
+        }
+        if(!best_normal.factor()){ return False; }
+
+        double line_confidence = problem.confidence(best_fit);
+        if(!(line_confidence >= MIN_LINE_CONFIDENCE)){ return False; }
+
+        // R = Rz(guinada) tilt
+        Pose pose;
+        double c = std::cos(best[2]), s = std::sin(best[2]);
+        for(int j = 0; j < 3; j++){
+            pose.R[0][j] = c * problem.tilt[0][j] - s * problem.tilt[1][j];
+            pose.R[1][j] = s * problem.tilt[0][j] + c * problem.tilt[1][j];
+            pose.R[2][j] = problem.tilt[2][j];
+        }
+        pose.t = {best[0], best[1], problem.height};
+        __publish(pose, best_normal.inverse_trace(2) + problem.height_variance, line_confidence);
+        return True;
+    }
+
+    ///< Grava a pose nos atributos públicos e como pose anterior das próximas visões
+    void
+    __publish(const Pose& pose, double position_variance, double pose_confidence){
+        for(int i = 0; i < 3; i++){ my_position[i] = float(pose.t[i]); }
+        my_orientation = pose.angles();
+        position_error = float(std::sqrt(position_variance));
+        confidence = float(pose_confidence);
+        visions_since_fix = 0;
+        __pose = pose;
+        __has_fix = True;
+    }
+
+    ///< Visão sem nova pose: a anterior continua publicada, envelhecida
+    void
+    __coast(){
+        confidence *= CONFIDENCE_DECAY;
+        position_error = std::fmin(position_error + DRIFT_PER_VISION, 99.0f);
+        visions_since_fix++;
+    }
 
-};
\ No newline at end of file
+    Pose __pose{};          ///< Última pose publicada
+    Pose __reference{};     ///< Pose no início da visão atual (ponto de partida das linhas)
+    bool __has_fix = False; ///< Já houve alguma pose
+};
@@ -0,0 +1,326 @@
+#include "../../Environment.hpp"
+#include "../../sample_messages.hpp"
+#include "../../../Communication/FrameRecorder.hpp"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Benchmark de Localization::localize().
+ *
+ * Uso: ./a.out [captura] [--poses N]
+ *
+ *   - sintético: N poses aleatórias da câmera no campo (altura de cabeça, guinada qualquer, arfagem ±30°,
+ *     rolagem ±5°), marcos dentro do campo de visão de 120°, leituras com o ruído do servidor
+ *     (gaussiano de FieldNoise e arredondamento a 2 casas). Agrupado pela quantidade de marcos vistos:
+ *     tempo (mediana, p99 e máximo), erro de posição e de guinada contra a pose verdadeira, confiança.
+ *   - linhas: as mesmas poses sem marcos, só com os segmentos de linha no campo de visão (as pontas
+ *     cortadas por ele, o círculo central em 16 segmentos), partindo de uma pose anterior com erro de
+ *     ~0.3 m e ~8° de guinada. Agrupado pela quantidade de linhas vistas.
+ *   - gravado: as mensagens reais de sample_messages.hpp e, se informada, uma captura do FrameRecorder
+ *     (make capture na raiz), passadas pelo Environment de cada agente; sem pose verdadeira,
+ *     imprime o tempo, a confiança e o desvio estimado da posição. As mensagens de sample_messages.hpp vêm
+ *     de um campo de 21 x 14 m (bandeiras a 14 m uma da outra), não do de 30 x 20 m de list_landmark: a
+ *     confiança perto de zero nelas é a resposta esperada a leituras incompatíveis com a tabela.
+ *
+ * Todas as linhas informam a fração das chamadas dentro de Localization::BUDGET_US.
+ */
+
+static constexpr double DEG = 3.14159265358979323846 / 180.0;
+
+/**
+ * @struct Stats
+ * @brief Amostras de uma linha do relatório.
+ */
+struct Stats {
+    std::vector<double> ns;
+    std::vector<double> position_error;  ///< Contra a verdade (m)
+    std::vector<double> yaw_error;       ///< Contra a verdade (graus)
+    std::vector<double> confidence;
+    std::vector<double> estimated_error; ///< Localization::position_error (m)
+    size_t failures = 0;
+};
+
+static double
+percentile(std::vector<double> values, double p){
+    if(values.empty()){ return NAN; }
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, size_t(p * double(values.size())))];
+}
+
+/**
+ * @brief Mede a única chamada de localize() da visão, como no agente (repeti-la envelheceria uma visão sem solução).
+ */
+static double
+time_localize(Localization& loc, bool is_left, bool& solved){
+    auto start = std::chrono::steady_clock::now();
+    solved = loc.localize(is_left);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void
+print_row(const char* name, const Stats& s){
+    double within = 0.0;
+    for(double ns : s.ns){ within += (ns <= Localization::BUDGET_US * 1000.0) ? 1.0 : 0.0; }
+    std::printf("%-10s %7zu %9.0f %9.0f %9.0f %8.1f%% %9.4f %9.4f %8.3f %7.2f %9.4f %6zu\n",
+        name, s.ns.size(), percentile(s.ns, 0.5), percentile(s.ns, 0.99), percentile(s.ns, 1.0),
+        s.ns.empty() ? 0.0 : 100.0 * within / double(s.ns.size()),
+        percentile(s.position_error, 0.5), percentile(s.position_error, 0.95), percentile(s.yaw_error, 0.5),
+        percentile(s.confidence, 0.5), percentile(s.estimated_error, 0.5), s.failures);
+}
+
+/**
+ * @brief Leitura do servidor para um ponto no referencial da câmera: polar com ruído, arredondada a 2 casas.
+ */
+static void
+observe(const double p[3], std::mt19937_64& rng, float out[3]){
+    std::normal_distribution<double> gauss(0.0, 1.0);
+    double planar = std::sqrt(p[0] * p[0] + p[1] * p[1]);
+    double r = std::sqrt(planar * planar + p[2] * p[2]);
+    double polar[3] = {
+        r * (1.0 + FieldNoise::SIGMA_R / 100.0 * gauss(rng)),
+        std::atan2(p[1], p[0]) / DEG + FieldNoise::SIGMA_H * gauss(rng),
+        std::atan2(p[2], planar) / DEG + FieldNoise::SIGMA_V * gauss(rng)
+    };
+    for(int i = 0; i < 3; i++){ out[i] = float(std::round(polar[i] * 100.0) / 100.0); }
+}
+
+/**
+ * @brief R = Rz(yaw) Ry(pitch) Rx(roll), ângulos em radianos.
+ */
+static void
+rotation(double yaw, double pitch, double roll, double R[3][3]){
+    double cy = std::cos(yaw), sy = std::sin(yaw), cp = std::cos(pitch), sp = std::sin(pitch), cr = std::cos(roll), sr = std::sin(roll);
+    double M[3][3] = {
+        {cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr},
+        {sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr},
+        {-sp, cp * sr, cp * cr}
+    };
+    std::memcpy(R, M, sizeof(M));
+}
+
+///< Ponto do campo no referencial da câmera (R, t)
+static void
+to_camera(const double R[3][3], const double t[3], const double L[3], double p[3]){
+    double d[3] = {L[0] - t[0], L[1] - t[1], L[2] - t[2]};
+    for(int k = 0; k < 3; k++){ p[k] = R[0][k] * d[0] + R[1][k] * d[1] + R[2][k] * d[2]; }
+}
+
+///< Dentro do campo de visão de 120° (horizontal e vertical)
+static bool
+in_view(const double p[3]){
+    double planar = std::sqrt(p[0] * p[0] + p[1] * p[1]);
+    return std::fabs(std::atan2(p[1], p[0])) <= 60.0 * DEG && std::fabs(std::atan2(p[2], planar)) <= 60.0 * DEG;
+}
+
+static void
+synthetic(size_t poses, std::vector<Stats>& by_count){
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    Localization loc;
+
+    for(size_t n = 0; n < poses; n++){
+        double x = 14.0 * unit(rng), y = 9.5 * unit(rng), z = 0.5 + 0.05 * unit(rng);
+        double yaw = 180.0 * unit(rng) * DEG, pitch = 30.0 * unit(rng) * DEG, roll = 5.0 * unit(rng) * DEG;
+
+        double R[3][3], t[3] = {x, y, z};
+        rotation(yaw, pitch, roll, R);
+
+        loc.begin_vision();
+        for(size_t i = 0; i < loc.list_landmark.size(); i++){
+            const float* fixed = loc.list_landmark[i].fixed_position;
+            double L[3] = {fixed[0], fixed[1], fixed[2]}, p[3];
+            to_camera(R, t, L, p);
+            if(!in_view(p)){ continue; }
+            float polar[3];
+            observe(p, rng, polar);
+            loc.update_visible_landmark(i, polar);
+        }
+
+        size_t count = loc.visibles_landmarks.size();
+        if(count < 2){ continue; }
+        Stats& s = by_count[count];
+
+        bool solved = false;
+        s.ns.push_back(time_localize(loc, True, solved));
+        if(!solved){ s.failures++; continue; }
+        s.position_error.push_back(std::hypot(loc.my_position[0] - x, loc.my_position[1] - y, loc.my_position[2] - z));
+        s.yaw_error.push_back(std::fabs(std::remainder(loc.my_orientation[0] - yaw / DEG, 360.0)));
+        s.confidence.push_back(loc.confidence);
+        s.estimated_error.push_back(loc.position_error);
+    }
+}
+
+/**
+ * @brief Segmentos de linha do campo como o servidor os descreve: os de FieldDistance e o círculo central em 16 partes.
+ */
+static std::vector<std::array<double, 4>>
+field_segments(){
+    using F = FieldDistance;
+    const double L = F::HALF_LENGTH, W = F::HALF_WIDTH, P = L - F::PENALTY_DEPTH, A = F::PENALTY_HALF_WIDTH;
+    std::vector<std::array<double, 4>> segments = {
+        {-L, -W, +L, -W}, {-L, +W, +L, +W}, {-L, -W, -L, +W}, {+L, -W, +L, +W}, {0.0, -W, 0.0, +W},
+        {-P, -A, -P, +A}, {-L, -A, -P, -A}, {-L, +A, -P, +A}, {+P, -A, +P, +A}, {+P, -A, +L, -A}, {+P, +A, +L, +A}
+    };
+    for(int i = 0; i < 16; i++){
+        double a = 2.0 * 3.14159265358979323846 * i / 16.0, b = 2.0 * 3.14159265358979323846 * (i + 1) / 16.0;
+        segments.push_back({F::CIRCLE_RADIUS * std::cos(a), F::CIRCLE_RADIUS * std::sin(a), F::CIRCLE_RADIUS * std::cos(b), F::CIRCLE_RADIUS * std::sin(b)});
+    }
+    return segments;
+}
+
+/**
+ * @brief Acompanhamento pelas linhas: uma pose anterior com erro (dada por todos os marcos, sem ruído),
+ * depois uma visão só com as linhas da pose verdadeira.
+ */
+static void
+lines(size_t poses, std::vector<Stats>& by_count){
+    std::mt19937_64 rng(13);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    std::normal_distribution<double> gauss(0.0, 1.0);
+    const std::vector<std::array<double, 4>> segments = field_segments();
+    Localization loc;
+
+    for(size_t n = 0; n < poses; n++){
+        double x = 14.0 * unit(rng), y = 9.5 * unit(rng), z = 0.5 + 0.05 * unit(rng);
+        double yaw = 180.0 * unit(rng) * DEG, pitch = 30.0 * unit(rng) * DEG, roll = 5.0 * unit(rng) * DEG;
+        double R[3][3], t[3] = {x, y, z};
+        rotation(yaw, pitch, roll, R);
+
+        // Pose anterior: ~0.3 m e ~8° de guinada de erro, arfagem e rolagem de antes do movimento da cabeça
+        double previous_R[3][3], previous_t[3] = {x + 0.2 * gauss(rng), y + 0.2 * gauss(rng), 0.5};
+        rotation(yaw + 8.0 * DEG * gauss(rng), pitch + 5.0 * DEG * gauss(rng), 0.0, previous_R);
+        loc.begin_vision();
+        for(size_t i = 0; i < loc.list_landmark.size(); i++){
+            const float* fixed = loc.list_landmark[i].fixed_position;
+            double L[3] = {fixed[0], fixed[1], fixed[2]}, p[3];
+            to_camera(previous_R, previous_t, L, p);
+            double planar = std::sqrt(p[0] * p[0] + p[1] * p[1]);
+            float polar[3] = {float(std::sqrt(planar * planar + p[2] * p[2])), float(std::atan2(p[1], p[0]) / DEG), float(std::atan2(p[2], planar) / DEG)};
+            loc.update_visible_landmark(i, polar);
+        }
+        if(!loc.localize(True)){ continue; }
+
+        // Visão atual: só linhas, com as pontas cortadas pelo campo de visão
+        loc.begin_vision();
+        for(const auto& segment : segments){
+            constexpr int STEPS = 64;
+            int first = -1, last = -1;
+            for(int k = 0; k <= STEPS; k++){
+                double f = double(k) / STEPS;
+                double L[3] = {segment[0] + f * (segment[2] - segment[0]), segment[1] + f * (segment[3] - segment[1]), 0.0}, p[3];
+                to_camera(R, t, L, p);
+                if(in_view(p)){ if(first < 0){ first = k; } last = k; }
+            }
+            if(first < 0 || first == last){ continue; }
+
+            float ends[2][3];
+            int index[2] = {first, last};
+            for(int e = 0; e < 2; e++){
+                double f = double(index[e]) / STEPS;
+                double L[3] = {segment[0] + f * (segment[2] - segment[0]), segment[1] + f * (segment[3] - segment[1]), 0.0}, p[3];
+                to_camera(R, t, L, p);
+                observe(p, rng, ends[e]);
+            }
+            loc.update_visible_line(ends[0], ends[1]);
+        }
+
+        size_t count = std::min<size_t>(loc.line_count, by_count.size() - 1);
+        if(count < 2){ continue; }
+        Stats& s = by_count[count];
+
+        bool solved = false;
+        s.ns.push_back(time_localize(loc, True, solved));
+        if(!solved){ s.failures++; continue; }
+        s.position_error.push_back(std::hypot(loc.my_position[0] - x, loc.my_position[1] - y, loc.my_position[2] - z));
+        s.yaw_error.push_back(std::fabs(std::remainder(loc.my_orientation[0] - yaw / DEG, 360.0)));
+        s.confidence.push_back(loc.confidence);
+        s.estimated_error.push_back(loc.position_error);
+    }
+}
+
+/**
+ * @brief Frames reais: cada um passa pelo Environment do seu agente e, como no agente, por Environment::localize
+ * (que também publica o estado); os que têm visão com 2 marcos ou mais são medidos.
+ */
+static void
+recorded(std::vector<Environment>& envs, int unum, std::string_view frame, Stats& s){
+    Environment& env = envs[(unum >= 0 && unum < 23) ? unum : 0];
+    env.update_from_server(frame);
+    bool measured = frame.find("(See") != std::string_view::npos && env.loc.visibles_landmarks.size() >= 2;
+
+    auto start = std::chrono::steady_clock::now();
+    bool vision = env.localize();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    if(!vision || !measured){ return; }
+
+    s.ns.push_back(ns);
+    if(env.loc.visions_since_fix != 0){ s.failures++; return; }
+    s.confidence.push_back(env.loc.confidence);
+    s.estimated_error.push_back(env.loc.position_error);
+}
+
+int
+main(int argc, char** argv){
+
+    const char* capture = nullptr;
+    size_t poses = 200000;
+    for(int i = 1; i < argc; i++){
+        if(std::strcmp(argv[i], "--poses") == 0 && i + 1 < argc){ poses = std::strtoull(argv[++i], nullptr, 10); }
+        else { capture = argv[i]; }
+    }
+
+    std::vector<Stats> by_count(9);
+    synthetic(poses, by_count);
+    std::vector<Stats> by_lines(9); // A última linha junta 8 ou mais
+    lines(poses, by_lines);
+
+    std::vector<Environment> envs;
+    envs.reserve(23);
+    for(int unum = 0; unum < 23; unum++){
+        envs.emplace_back(Logger::get());
+        envs.back().unum = unum;
+    }
+
+    Stats samples;
+    for(std::string_view msg : SAMPLE_MESSAGES){
+        for(int repeat = 0; repeat < 100; repeat++){ recorded(envs, 0, msg, samples); }
+    }
+    const Localization& sample = envs[0].loc;
+    std::printf("Amostra real: camera em (%.2f, %.2f, %.2f), guinada %.1f, confianca %.2f\n",
+        sample.my_position[0], sample.my_position[1], sample.my_position[2], sample.my_orientation[0], sample.confidence);
+
+    Stats frames;
+    if(capture){
+        FrameReplayer replayer;
+        if(!replayer.open(capture)){ std::fprintf(stderr, "Captura invalida: %s\n", capture); return 1; }
+        replayer.replay([&](int unum, std::string_view frame){ recorded(envs, unum, frame, frames); });
+    }
+
+    std::printf("Grade de distancia as linhas: %s, %zu KB\n",
+        FieldDistance::shared().is_mapped() ? "mapeada do arquivo" : "construida na memoria", FieldDistance::bytes() / 1024);
+    std::printf("\n=== Localization::localize, orcamento %.0f us ===\n", Localization::BUDGET_US);
+    std::printf("%-10s %7s %9s %9s %9s %9s %9s %9s %8s %7s %9s %6s\n",
+        "marcos", "casos", "ns med", "ns p99", "ns max", "no orc.", "erro med", "erro p95", "guin.med", "conf.", "desvio", "falhas");
+    char name[32];
+    for(size_t count = 2; count < by_count.size(); count++){
+        if(by_count[count].ns.empty()){ continue; }
+        std::snprintf(name, sizeof(name), "%zu", count);
+        print_row(name, by_count[count]);
+    }
+    for(size_t count = 2; count < by_lines.size(); count++){
+        if(by_lines[count].ns.empty()){ continue; }
+        std::snprintf(name, sizeof(name), "linhas %zu%s", count, count + 1 == by_lines.size() ? "+" : "");
+        print_row(name, by_lines[count]);
+    }
+    print_row("amostras", samples);
+    if(capture){ print_row("captura", frames); }
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include "FieldDistance.hpp"
+
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+
+/**
+ * Gera o arquivo da grade de FieldDistance, para ser mapeado pelos agentes em vez de construído.
+ *
+ * Uso: ./a.out [arquivo]   (padrão: FieldDistance::DEFAULT_FILE, procurado na pasta de onde o agente é iniciado)
+ *
+ * Relata o tempo de construção e de mapeamento, o tamanho e o erro da interpolação contra a distância exata.
+ */
+int
+main(int argc, char** argv){
+
+    const char* path = (argc > 1) ? argv[1] : FieldDistance::DEFAULT_FILE;
+
+    auto start = std::chrono::steady_clock::now();
+    FieldDistance built;
+    built.build();
+    double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if(!built.save(path)){ std::fprintf(stderr, "Falha ao gravar %s\n", path); return 1; }
+
+    start = std::chrono::steady_clock::now();
+    FieldDistance mapped;
+    if(!mapped.load(path)){ std::fprintf(stderr, "Falha ao mapear %s\n", path); return 1; }
+    double load_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Erro da interpolação (e igualdade com a grade construída) em pontos aleatórios do campo e da margem
+    std::mt19937_64 rng(5);
+    std::uniform_real_distribution<double> x(-FieldDistance::HALF_LENGTH - FieldDistance::MARGIN, FieldDistance::HALF_LENGTH + FieldDistance::MARGIN);
+    std::uniform_real_distribution<double> y(-FieldDistance::HALF_WIDTH - FieldDistance::MARGIN, FieldDistance::HALF_WIDTH + FieldDistance::MARGIN);
+    double worst = 0.0, worst_near = 0.0;
+    size_t different = 0;
+    for(int i = 0; i < 1000000; i++){
+        double px = x(rng), py = y(rng), dx, dy, mx, my;
+        double d = built(px, py, dx, dy);
+        if(mapped(px, py, mx, my) != d){ different++; }
+        double error = std::fabs(d - FieldDistance::exact(px, py));
+        worst = std::fmax(worst, error);
+        if(FieldDistance::exact(px, py) < 0.5){ worst_near = std::fmax(worst_near, error); }
+    }
+
+    std::printf("%s: %zu x %zu nos, %zu KB\n", path, FieldDistance::COLUMNS, FieldDistance::ROWS, FieldDistance::bytes() / 1024);
+    std::printf("construcao %.1f ms, mapeamento %.3f ms\n", build_ms, load_ms);
+    std::printf("erro maximo da interpolacao: %.4f m (%.4f m a menos de 0.5 m de uma linha)\n", worst, worst_near);
+    std::printf("consultas diferentes entre grade construida e mapeada: %zu\n", different);
+    return different == 0 ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+#include "WorldState.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @class SeqlockSnapshot
+ * @brief Publicação de um valor por um único escritor para vários leitores, sem locks.
+ * @details
+ * Dois slots, cada um protegido por uma sequência (seqlock). O escritor grava sempre no slot
+ * que não contém a última publicação, marcando a sequência como ímpar durante a escrita e par
+ * ao terminar, e então avança a versão: `publish` nunca espera por leitores.
+ *
+ * O leitor copia o slot da última versão e confere a sequência antes e depois da cópia.
+ * Como o escritor está ocupado no outro slot, a releitura só acontece se ele publicar duas vezes
+ * durante uma única cópia: na prática, a leitura é uma cópia de tamanho constante.
+ *
+ * @tparam T Tipo trivialmente copiável (copiado com memcpy).
+ */
+template<typename T>
+class SeqlockSnapshot {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqlockSnapshot: T deve ser trivialmente copiável");
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence{0}; ///< Ímpar enquanto o escritor grava neste slot
+        T value{};
+    };
+
+    Slot __slots[2];
+    alignas(64) std::atomic<uint64_t> __version{0}; ///< Quantidade de publicações
+
+public:
+    /**
+     * @brief Publica um novo valor montado diretamente no slot livre (somente o escritor).
+     * @tparam Fill Invocável `void(T&)`; recebe o slot com o conteúdo de duas publicações atrás.
+     */
+    template<typename Fill>
+    void publish_with(Fill&& fill) {
+        uint64_t version = this->__version.load(std::memory_order_relaxed) + 1;
+        Slot& slot = this->__slots[version & 1];
+
+        uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        fill(slot.value);
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+
+        this->__version.store(version, std::memory_order_release);
+    }
+
+    /**
+     * @brief Publica uma cópia de `value` (somente o escritor).
+     */
+    void publish(const T& value) {
+        this->publish_with([&value](T& slot){ std::memcpy(static_cast<void*>(&slot), &value, sizeof(T)); });
+    }
+
+    /**
+     * @brief Copia a última publicação, garantidamente sem mistura entre versões.
+     * @param[out] out Destino da cópia.
+     * @param[out] retries Se não nulo, recebe quantas cópias foram descartadas.
+     * @return Versão lida (0 antes da primeira publicação, com `T{}`).
+     */
+    uint64_t read(T& out, uint64_t* retries = nullptr) const {
+        for(uint64_t attempt = 0;; attempt++){
+            uint64_t version = this->__version.load(std::memory_order_acquire);
+            const Slot& slot = this->__slots[version & 1];
+
+            uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if(before & 1){ continue; } // O escritor voltou a este slot e ainda o grava
+
+            std::memcpy(static_cast<void*>(&out), &slot.value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if(slot.sequence.load(std::memory_order_relaxed) == before){
+                if(retries){ *retries = attempt; }
+                return version;
+            }
+        }
+    }
+
+    /**
+     * @brief Versão da última publicação.
+     */
+    uint64_t version() const { return this->__version.load(std::memory_order_acquire); }
+};
+
+/**
+ * @struct WorldSnapshot
+ * @brief Tudo o que o Environment sabe ao fim de uma percepção, em um bloco copiável.
+ */
+struct WorldSnapshot {
+    float time_server = 0;
+    float time_match = 0;
+    uint8_t goals_scored = 0;
+    uint8_t goals_conceded = 0;
+    uint8_t unum = 0;
+    bool is_left = False;
+    uint8_t current_mode = 0;  ///< Environment::PlayMode
+    std::array<float, 3> my_position{};     ///< Localization::my_position
+    std::array<float, 3> my_orientation{};  ///< Localization::my_orientation
+    float localization_confidence = 0;
+    float localization_error = 99;          ///< Localization::position_error (m)
+    uint32_t visions_since_fix = 0;         ///< Localization::visions_since_fix
+    WorldState world;
+};
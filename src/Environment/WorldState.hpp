@@ -0,0 +1,170 @@
+#pragma once
+
+#include "../Booting/booting_templates.hpp"
+#include "ServerTags.hpp"
+#include "TeamMessage.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @struct PolarSoA
+ * @brief Coordenadas polares de até `N` objetos vistos, em struct-of-arrays.
+ * @details Distância (m), ângulo horizontal e vertical (graus), cada um em um array contíguo
+ * e alinhado: laços sobre `[0, count)` são vetorizáveis pelo compilador.
+ */
+template<size_t N>
+struct PolarSoA {
+    alignas(64) std::array<float, N> distance{};
+    alignas(64) std::array<float, N> horizontal{};
+    alignas(64) std::array<float, N> vertical{};
+
+    /**
+     * @brief Grava o objeto `i` a partir de (distância, horizontal, vertical).
+     */
+    void set(size_t i, const float polar[3]) {
+        this->distance[i] = polar[0];
+        this->horizontal[i] = polar[1];
+        this->vertical[i] = polar[2];
+    }
+};
+
+/**
+ * @class WorldState
+ * @brief Estado percebido do mundo em um ciclo, com capacidade fixa, preenchido pelo parser.
+ * @details
+ * Tudo é alocado na construção (arrays de tamanho fixo): interpretar uma percepção não aloca.
+ * Dados que se repetem (juntas, jogadores, linhas) ficam em struct-of-arrays alinhados a 64 bytes,
+ * de modo que consumidores percorram cada grandeza como um array contíguo de floats.
+ *
+ * Quantidades variáveis (jogadores e linhas vistos) têm um contador, zerado em `begin_cycle`;
+ * o que não foi percebido no ciclo mantém o valor anterior e é sinalizado por flags (`ball_visible`,
+ * `foot_touching`).
+ */
+class WorldState {
+public:
+    static constexpr size_t MAX_PLAYERS = 22;  ///< Jogadores vistos (os dois times)
+    static constexpr size_t BODY_PARTS = 5;    ///< head, rlowerarm, llowerarm, rfoot, lfoot
+    static constexpr size_t MAX_LINES = 32;    ///< Segmentos de linha do campo vistos
+    static constexpr size_t JOINT_LANES = (JOINT_COUNT + 7) / 8 * 8; ///< JOINT_COUNT arredondado para registros de 8 floats
+
+    // --- Juntas (índice = JOINTS.find(nome) = Effector) ---
+    alignas(64) std::array<float, JOINT_LANES> joint_angle{};  ///< Ângulo (graus)
+    alignas(64) std::array<float, JOINT_LANES> joint_speed{};  ///< Velocidade (graus/s), derivada entre ciclos
+
+    // --- IMU do torso ---
+    std::array<float, 3> gyro{};  ///< Velocidade angular (graus/s)
+    std::array<float, 3> acc{};   ///< Aceleração linear (m/s^2)
+
+    // --- Sensores de força dos pés (0 = esquerdo 'lf', 1 = direito 'rf') ---
+    std::array<std::array<float, 3>, 2> foot_contact{};  ///< Ponto de contato relativo ao pé (m)
+    std::array<std::array<float, 3>, 2> foot_force{};    ///< Força (N)
+    std::array<bool, 2> foot_touching{};                 ///< O pé tocou algo neste ciclo
+
+    // --- Bola ---
+    bool ball_visible = False;
+    std::array<float, 3> ball_polar{};     ///< (distância, horizontal, vertical) relativo à câmera
+    std::array<float, 3> ball_position{};  ///< Cartesiano relativo à câmera (m)
+
+    // --- Jogadores vistos ---
+    uint8_t player_count = 0;
+    std::array<uint8_t, MAX_PLAYERS> player_id{};        ///< Número do uniforme (0 se não visto)
+    std::array<bool, MAX_PLAYERS> player_teammate{};     ///< Do nosso time
+    std::array<uint8_t, MAX_PLAYERS> player_parts{};     ///< Bit `p` ligado se a parte `p` foi vista
+    std::array<PolarSoA<MAX_PLAYERS>, BODY_PARTS> body{}; ///< body[parte] (ordem de PlayerTag a partir de HEAD)
+
+    // --- Linhas vistas ---
+    uint8_t line_count = 0;
+    PolarSoA<MAX_LINES> line_start{};
+    PolarSoA<MAX_LINES> line_end{};
+
+    // --- Companheiros (hear), persistente entre ciclos ---
+    TeamKnowledge team{};
+
+private:
+    alignas(64) std::array<float, JOINT_LANES> __previous_angle{};
+    float __previous_time = -1.0f;
+
+public:
+    /**
+     * @brief Converte coordenadas polares do servidor (graus) em cartesianas.
+     */
+    static void polar_to_cartesian(const float polar[3], float out[3]) {
+        constexpr float DEG = 3.14159265358979f / 180.0f;
+        float h = polar[1] * DEG, v = polar[2] * DEG;
+        float planar = polar[0] * std::cos(v);
+        out[0] = planar * std::cos(h);
+        out[1] = planar * std::sin(h);
+        out[2] = polar[0] * std::sin(v);
+    }
+
+    /**
+     * @brief Início da interpretação de uma percepção: zera o que só vale para este ciclo.
+     */
+    void begin_cycle() {
+        this->player_count = 0;
+        this->line_count = 0;
+        this->ball_visible = False;
+        this->foot_touching = {False, False};
+    }
+
+    /**
+     * @brief Fim da interpretação: deriva as velocidades das juntas.
+     * @param time_server Instante do servidor desta percepção.
+     */
+    void end_cycle(float time_server) {
+        float dt = time_server - this->__previous_time;
+        float inverse = (this->__previous_time >= 0.0f && dt > 0.0f) ? 1.0f / dt : 0.0f;
+        for(size_t i = 0; i < JOINT_LANES; i++){
+            this->joint_speed[i] = (this->joint_angle[i] - this->__previous_angle[i]) * inverse;
+        }
+        this->__previous_angle = this->joint_angle;
+        this->__previous_time = time_server;
+    }
+
+    /**
+     * @brief Grava a bola vista, em polar e cartesiano.
+     */
+    void set_ball(const float polar[3]) {
+        this->ball_visible = True;
+        this->ball_polar = {polar[0], polar[1], polar[2]};
+        polar_to_cartesian(polar, this->ball_position.data());
+    }
+
+    /**
+     * @brief Reserva a próxima posição de jogador visto.
+     * @return Índice do jogador, ou -1 se a capacidade se esgotou.
+     */
+    int add_player() {
+        if(this->player_count >= MAX_PLAYERS){ return -1; }
+        int i = this->player_count++;
+        this->player_id[i] = 0;
+        this->player_teammate[i] = False;
+        this->player_parts[i] = 0;
+        return i;
+    }
+
+    /**
+     * @brief Grava uma parte do corpo de um jogador visto.
+     * @param part Índice da parte (PlayerTag - PlayerTag::HEAD).
+     */
+    void set_body_part(int player, size_t part, const float polar[3]) {
+        if(player < 0 || part >= BODY_PARTS){ return; }
+        this->body[part].set(size_t(player), polar);
+        this->player_parts[player] |= uint8_t(1u << part);
+    }
+
+    /**
+     * @brief Grava um segmento de linha visto.
+     * @return False se a capacidade se esgotou.
+     */
+    bool add_line(const float start[3], const float end[3]) {
+        if(this->line_count >= MAX_LINES){ return False; }
+        this->line_start.set(this->line_count, start);
+        this->line_end.set(this->line_count, end);
+        this->line_count++;
+        return True;
+    }
+};
@@ -0,0 +1,98 @@
+#include "FastFloat.hpp"
+#include "sample_messages.hpp"
+#include "../Communication/FrameRecorder.hpp"
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <charconv>
+
+/**
+ * Benchmark da conversão de floats: std::from_chars x parse_server_float.
+ *
+ * Uso: ./a.out [captura]
+ *   Extrai todos os números (tokens que começam com dígito ou '-') das mensagens de
+ *   sample_messages.hpp ou de uma captura do FrameRecorder (make capture na raiz),
+ *   confere que as duas conversões produzem exatamente os mesmos bits e mede ns/float.
+ */
+
+/**
+ * @brief Separa os tokens numéricos de uma mensagem (delimitados por ' ', '(' e ')').
+ */
+static void
+collect_numbers(std::string_view msg, std::vector<std::string_view>& out){
+    size_t i = 0;
+    while(i < msg.size()){
+        while(i < msg.size() && (msg[i] == ' ' || msg[i] == '(' || msg[i] == ')')){ i++; }
+        size_t start = i;
+        while(i < msg.size() && msg[i] != ' ' && msg[i] != '(' && msg[i] != ')'){ i++; }
+        if(i > start && (msg[start] == '-' || (msg[start] >= '0' && msg[start] <= '9'))){ out.push_back(msg.substr(start, i - start)); }
+    }
+}
+
+/**
+ * @brief Converte todos os números `rounds` vezes e retorna ns/float.
+ */
+template<typename Convert>
+static double
+measure(const std::vector<std::string_view>& numbers, size_t rounds, float& sink, Convert&& convert){
+    auto start = std::chrono::steady_clock::now();
+    for(size_t r = 0; r < rounds; r++){
+        for(std::string_view n : numbers){
+            float value;
+            convert(n.data(), n.data() + n.size(), value);
+            sink += value;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / (double(rounds) * double(numbers.size()));
+}
+
+int
+main(int argc, char** argv){
+
+    std::vector<std::string> messages;
+    if(argc > 1){
+        FrameReplayer replayer;
+        if(!replayer.open(argv[1])){ std::fprintf(stderr, "Captura invalida: %s\n", argv[1]); return 1; }
+        replayer.replay([&messages](int, std::string_view frame){ messages.emplace_back(frame); });
+    }
+    else {
+        for(std::string_view msg : SAMPLE_MESSAGES){ messages.emplace_back(msg); }
+    }
+
+    std::vector<std::string_view> numbers;
+    for(const auto& msg : messages){ collect_numbers(msg, numbers); }
+    if(numbers.empty()){ std::fprintf(stderr, "Nenhum numero encontrado\n"); return 1; }
+
+    // Os dois caminhos devem concordar bit a bit
+    size_t mismatches = 0;
+    for(std::string_view n : numbers){
+        float a = 0.0f, b = 0.0f;
+        std::from_chars(n.data(), n.data() + n.size(), a);
+        parse_server_float(n.data(), n.data() + n.size(), b);
+        if(std::memcmp(&a, &b, sizeof(float)) != 0){
+            if(mismatches++ < 5){ std::printf("  divergencia: '%.*s' -> %.9g x %.9g\n", int(n.size()), n.data(), a, b); }
+        }
+    }
+
+    const size_t target = 20'000'000;
+    size_t rounds = std::max<size_t>(1, target / numbers.size());
+    float sink = 0.0f;
+
+    double baseline = measure(numbers, rounds, sink, [](const char* f, const char* l, float& v){ std::from_chars(f, l, v); });
+    double fast = measure(numbers, rounds, sink, [](const char* f, const char* l, float& v){ parse_server_float(f, l, v); });
+
+    std::printf(
+        "%zu mensagens, %zu numeros (%.1f por mensagem), %zu divergencias\n",
+        messages.size(), numbers.size(), double(numbers.size()) / double(messages.size()), mismatches
+    );
+    std::printf("[from_chars        ] %6.2f ns/float\n", baseline);
+    std::printf("[parse_server_float] %6.2f ns/float (%.1fx)\n", fast, baseline / fast);
+    std::printf("(soma de controle: %g)\n", sink);
+
+    return mismatches == 0 ? 0 : 1;
+}
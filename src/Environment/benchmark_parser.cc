@@ -0,0 +1,205 @@
+#include "Environment.hpp"
+#include "sample_messages.hpp"
+#include "../Communication/FrameRecorder.hpp"
+#include "../Utils/MockServer/MockServer.hpp"
+#include "../Utils/Benchmark/Counters.hpp"
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+/**
+ * Benchmark do parser (Environment::update_from_server) sobre um corpus de percepções.
+ *
+ * Uso: ./a.out [captura] [--save arquivo] [--compare arquivo] [--mask todos|movimento|goleiro]
+ *
+ * Corpus:
+ *   - amostras: mensagens reais de sample_messages.hpp;
+ *   - gerado:   percepções do PerceptionGenerator com 22 jogadores vistos, 15 linhas e mensagens 'hear';
+ *   - captura:  frames gravados pelo FrameRecorder (make capture na raiz), se informada.
+ *
+ * Para cada corpus: ns/mensagem, MB/s, instruções/mensagem (perf_event, quando disponível)
+ * e alocações/mensagem. `--save` grava os resultados como linha de base, e `--compare` imprime a variação
+ * em relação a uma linha de base gravada antes da mudança.
+ *
+ * Compile com -DDISABLE_STRUCTURAL_INDEX para medir o cursor byte a byte original, e com
+ * -DDISABLE_FAST_FLOAT para converter os floats com std::from_chars em vez de parse_server_float.
+ * Com -DDISABLE_PADDED_COPY, update_from_server interpreta as mensagens no lugar, sem a cópia com sentinelas
+ * que torna a leitura segura contra frames truncados (Environment::PADDING): cada mensagem do corpus já é
+ * guardada seguida de Environment::SENTINEL, e `make benchmark_padding` compara as duas compilações.
+ * O "estado" impresso ao final deve ser idêntico entre as variantes.
+ *
+ * `--mask` restringe os blocos interpretados (Environment::interests): `movimento` = MOTION_TAGS,
+ * `goleiro` = NO_LINE_TAGS. Compare com `--compare` contra uma linha de base gravada com `todos`.
+ */
+
+#if defined(DISABLE_PADDED_COPY)
+static const char* VARIANT = "sem copia";
+#elif defined(DISABLE_FAST_FLOAT)
+static const char* VARIANT = "from_chars";
+#elif defined(DISABLE_STRUCTURAL_INDEX)
+static const char* VARIANT = "byte a byte";
+#else
+static const char* VARIANT = StructuralIndex::BACKEND;
+#endif
+
+static TagMask interests = ALL_TAGS; ///< Máscara aplicada ao Environment medido (--mask)
+
+/**
+ * @struct Result
+ * @brief Medidas de um corpus.
+ */
+struct Result {
+    double ns = 0;            ///< ns por mensagem
+    double mb_per_s = 0;
+    double instructions = -1; ///< Instruções por mensagem (-1 se indisponível)
+    double allocations = 0;   ///< Alocações por mensagem
+};
+
+/**
+ * @brief Percepções geradas: visão a cada 3 ciclos (como no servidor), 22 jogadores e 'hear'.
+ */
+static std::vector<std::string>
+generated_corpus(size_t count){
+    PerceptionGenerator generator(7);
+    std::vector<std::string> messages;
+    messages.reserve(count);
+    for(size_t i = 0; i < count; i++){
+        float t = 0.02f * float(i);
+        messages.emplace_back(generator.build(t, t, 1, "PlayOn", i % 3 == 0, 22, int(i % 4)));
+    }
+    return messages;
+}
+
+/**
+ * @brief Mede update_from_server sobre as mensagens, repetidas até cerca de `target` interpretações.
+ */
+static Result
+measure(const char* name, const std::vector<std::string>& messages, InstructionCounter& instructions){
+    // Cada mensagem seguida das sentinelas, como a cópia de update_from_server (necessário com DISABLE_PADDED_COPY)
+    size_t bytes = 0;
+    std::vector<std::string> buffers;
+    std::vector<std::string_view> views;
+    buffers.reserve(messages.size());
+    views.reserve(messages.size());
+    for(const auto& msg : messages){
+        bytes += msg.size();
+        buffers.push_back(msg + std::string(Environment::SENTINEL.data(), Environment::PADDING));
+        views.emplace_back(buffers.back().data(), msg.size());
+    }
+
+    Environment env(Logger::get());
+    env.unum = 1;
+    env.is_left = True;
+    env.interests = interests;
+
+    // Aquecimento (caches e preditor de desvios)
+    for(std::string_view msg : views){ env.update_from_server(msg); env.loc.visibles_landmarks.clear(); }
+
+    const size_t target = 1'000'000;
+    size_t rounds = std::max<size_t>(1, target / messages.size());
+
+    uint64_t allocations = allocation_count.load();
+    instructions.start();
+    auto start = std::chrono::steady_clock::now();
+    for(size_t r = 0; r < rounds; r++){
+        for(std::string_view msg : views){
+            env.update_from_server(msg);
+            env.loc.visibles_landmarks.clear();
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t executed = instructions.stop();
+    allocations = allocation_count.load() - allocations;
+
+    double parsed = double(rounds) * double(messages.size());
+    Result result;
+    result.ns = seconds * 1e9 / parsed;
+    result.mb_per_s = double(bytes) * double(rounds) / 1e6 / seconds;
+    result.instructions = instructions.available() ? double(executed) / parsed : -1;
+    result.allocations = double(allocations) / parsed;
+
+    char instr[32];
+    if(result.instructions >= 0){ std::snprintf(instr, sizeof(instr), "%10.0f", result.instructions); }
+    else { std::snprintf(instr, sizeof(instr), "%10s", "n/d"); }
+
+    std::printf(
+        "[%-11s] %-9s %6zu msgs %7.0f B/msg | %8.1f ns/msg | %8.1f MB/s | %s instr/msg | %6.3f aloc/msg\n",
+        VARIANT, name, messages.size(), double(bytes) / double(messages.size()),
+        result.ns, result.mb_per_s, instr, result.allocations
+    );
+    std::printf(
+        "[%-11s] %-9s estado: time_server=%.2f time_match=%.2f unum=%d F1R=(%.2f %.2f %.2f) jogadores=%d linhas=%d\n",
+        VARIANT, name, env.time_server, env.time_match, env.unum,
+        env.loc.list_landmark[3].sph_position[0], env.loc.list_landmark[3].sph_position[1], env.loc.list_landmark[3].sph_position[2],
+        env.world.player_count, env.world.line_count
+    );
+    return result;
+}
+
+int
+main(int argc, char** argv){
+
+    const char* capture = nullptr;
+    const char* save = nullptr;
+    const char* compare = nullptr;
+    for(int i = 1; i < argc; i++){
+        if(std::strcmp(argv[i], "--save") == 0 && i + 1 < argc){ save = argv[++i]; }
+        else if(std::strcmp(argv[i], "--compare") == 0 && i + 1 < argc){ compare = argv[++i]; }
+        else if(std::strcmp(argv[i], "--mask") == 0 && i + 1 < argc){
+            std::string_view mask = argv[++i];
+            if(mask == "movimento"){ interests = MOTION_TAGS; }
+            else if(mask == "goleiro"){ interests = NO_LINE_TAGS; }
+            else if(mask != "todos"){ std::fprintf(stderr, "Mascara invalida: %s\n", argv[i]); return 1; }
+        }
+        else { capture = argv[i]; }
+    }
+
+    std::vector<std::pair<std::string, std::vector<std::string>>> corpora;
+
+    std::vector<std::string> samples;
+    for(std::string_view msg : SAMPLE_MESSAGES){ samples.emplace_back(msg); }
+    corpora.emplace_back("amostras", std::move(samples));
+    corpora.emplace_back("gerado", generated_corpus(300));
+
+    if(capture){
+        std::vector<std::string> frames;
+        FrameReplayer replayer;
+        if(!replayer.open(capture)){ std::fprintf(stderr, "Captura invalida: %s\n", capture); return 1; }
+        replayer.replay([&frames](int, std::string_view frame){ frames.emplace_back(frame); });
+        corpora.emplace_back("captura", std::move(frames));
+    }
+
+    InstructionCounter instructions;
+    std::map<std::string, Result> results;
+    for(const auto& [name, messages] : corpora){ results[name] = measure(name.c_str(), messages, instructions); }
+
+    // Linha de base: "corpus ns instr aloc" por linha
+    if(compare){
+        FILE* file = std::fopen(compare, "r");
+        if(!file){ std::fprintf(stderr, "Linha de base invalida: %s\n", compare); return 1; }
+        char name[64];
+        Result base;
+        while(std::fscanf(file, "%63s %lf %lf %lf", name, &base.ns, &base.instructions, &base.allocations) == 4){
+            auto it = results.find(name);
+            if(it == results.end()){ continue; }
+            const Result& now = it->second;
+            std::printf("[%-11s] %-9s vs base: ns/msg %+6.1f%%", VARIANT, name, 100.0 * (now.ns / base.ns - 1.0));
+            if(now.instructions >= 0 && base.instructions > 0){ std::printf(" | instr/msg %+6.1f%%", 100.0 * (now.instructions / base.instructions - 1.0)); }
+            std::printf(" | aloc/msg %+.3f\n", now.allocations - base.allocations);
+        }
+        std::fclose(file);
+    }
+
+    if(save){
+        FILE* file = std::fopen(save, "w");
+        if(!file){ std::fprintf(stderr, "Nao foi possivel gravar: %s\n", save); return 1; }
+        for(const auto& [name, r] : results){ std::fprintf(file, "%s %.3f %.1f %.4f\n", name.c_str(), r.ns, r.instructions, r.allocations); }
+        std::fclose(file);
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "Environment.hpp"
+#include "../Utils/MockServer/MockServer.hpp"
+#include "../Utils/Benchmark/Counters.hpp"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * Benchmark das mensagens do time: encode_team_message, decode_team_message e o 'hear' completo.
+ *
+ * Uso: ./a.out [mensagens]
+ *   1. Codifica mensagens aleatórias (bola, posição e intenção) e mede ns/mensagem.
+ *   2. Decodifica as mesmas mensagens e uma mistura com textos de outros times (rejeitados).
+ *   3. Interpreta percepções com 10 'hear' pelo Environment e compara com as mesmas sem 'hear'.
+ * Todas as etapas devem reportar 0 alocações por mensagem.
+ */
+
+static constexpr size_t ROUNDS = 200;
+
+template<typename Body>
+static double
+ns_per(size_t count, Body&& body){
+    auto start = std::chrono::steady_clock::now();
+    for(size_t r = 0; r < ROUNDS; r++){ body(); }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / (double(ROUNDS) * double(count));
+}
+
+int
+main(int argc, char** argv){
+
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000;
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> x(-15.0f, 15.0f), y(-10.0f, 10.0f);
+    std::vector<TeamMessage> messages(count);
+    for(size_t i = 0; i < count; i++){
+        messages[i] = TeamMessage{uint8_t(1 + i % 11), TeamIntent(i % size_t(TeamIntent::COUNT)), (i % 3) != 0, {x(rng), y(rng)}, {x(rng), y(rng)}};
+    }
+
+    std::vector<TeamMessageText> texts(count);
+    std::vector<TeamMessageText> noise(count);
+    for(size_t i = 0; i < count; i++){
+        texts[i] = encode_team_message(messages[i]);
+        for(char& c : noise[i].chars){ c = TEAM_MESSAGE_ALPHABET[rng() % TEAM_MESSAGE_ALPHABET.size()]; }
+    }
+
+    uint64_t sink = 0;
+    uint64_t allocations = allocation_count.load();
+
+    double encode = ns_per(count, [&](){
+        for(size_t i = 0; i < count; i++){ texts[i] = encode_team_message(messages[i]); sink += uint8_t(texts[i].chars[9]); }
+    });
+
+    TeamMessage heard;
+    double decode = ns_per(count, [&](){
+        for(size_t i = 0; i < count; i++){ sink += decode_team_message(texts[i].view(), heard); sink += heard.unum; }
+    });
+
+    size_t accepted_noise = 0;
+    double reject = ns_per(count, [&](){
+        for(size_t i = 0; i < count; i++){ accepted_noise += decode_team_message(noise[i].view(), heard); }
+    });
+    accepted_noise /= ROUNDS;
+
+    uint64_t codec_allocations = allocation_count.load() - allocations;
+
+    std::printf("encode: %6.1f ns/msg | %6.1f M msg/s\n", encode, 1e3 / encode);
+    std::printf("decode: %6.1f ns/msg | %6.1f M msg/s\n", decode, 1e3 / decode);
+    std::printf("ruido:  %6.1f ns/msg | aceitas %zu de %zu (%.2f%%)\n", reject, accepted_noise, count, 100.0 * double(accepted_noise) / double(count));
+    std::printf("alocacoes no codec: %llu\n", (unsigned long long)codec_allocations);
+
+    // Percepção completa com e sem 10 mensagens do time
+    PerceptionGenerator generator(3);
+    std::vector<std::string> with_hear, without_hear;
+    for(int i = 0; i < 300; i++){
+        float t = 0.02f * float(i);
+        with_hear.emplace_back(generator.build(t, t, 1, "PlayOn", i % 3 == 0, 10, 10));
+        without_hear.emplace_back(generator.build(t, t, 1, "PlayOn", i % 3 == 0, 10, 0));
+    }
+
+    Environment env(Logger::get());
+    env.unum = 1;
+    auto parse = [&env](const std::vector<std::string>& corpus){
+        return ns_per(corpus.size(), [&](){
+            for(const auto& msg : corpus){ env.update_from_server(msg); env.loc.visibles_landmarks.clear(); }
+        });
+    };
+    parse(with_hear); // Aquecimento
+    allocations = allocation_count.load();
+    double with = parse(with_hear);
+    double without = parse(without_hear);
+    uint64_t parse_allocations = allocation_count.load() - allocations;
+
+    std::printf("percepcao com 10 hear: %7.1f ns | sem: %7.1f ns | hear: %5.1f ns cada | alocacoes: %llu | recebidas: %u rejeitadas: %u\n",
+                with, without, (with - without) / 10.0, (unsigned long long)parse_allocations, env.world.team.received, env.world.team.rejected);
+
+    return sink == 0; // Impede que o compilador descarte os laços
+}
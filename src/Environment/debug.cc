@@ -1,17 +1,207 @@
 #include "Environment.hpp"
+#include "sample_messages.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
 
-const char* example = "(time (now 10.06))(GS (team left) (unum 1) (sl 3) (sr 2) (t 5.12) (pm BeforeKickOff))(GYR (n torso) (rt 0.01 -0.00 0.00))(ACC (n torso) (a -0.00 -0.00 0.01))(HJ (n hj1) (ax 0.00))(HJ (n hj2) (ax -0.00))(See (P (team RoboIME) (id 1) (rlowerarm (pol 0.18 -35.30 -22.17)) (llowerarm (pol 0.18 36.49 -21.66))) (G2R (pol 30.92 -19.31 0.55)) (G1R (pol 30.30 -15.73 0.47)) (F1R (pol 29.27 1.62 -1.01)) (F2R (pol 34.87 -33.26 -0.82)) (B (pol 16.91 -32.71 -1.64)) (L (pol 23.88 -53.55 -1.53) (pol 14.22 3.30 -2.23)) (L (pol 34.95 -33.18 -0.98) (pol 29.18 1.37 -1.25)) (L (pol 29.20 1.45 -1.09) (pol 1.07 59.96 -29.70)) (L (pol 34.98 -33.31 -0.90) (pol 22.18 -60.01 -1.25)) (L (pol 28.07 -12.48 -0.97) (pol 29.94 -23.73 -1.00)) (L (pol 28.07 -12.88 -1.02) (pol 29.83 -11.92 -1.07)) (L (pol 29.99 -23.90 -1.00) (pol 31.66 -22.86 -0.96)) (L (pol 18.62 -29.50 -1.68) (pol 17.73 -26.93 -1.76)) (L (pol 17.76 -26.80 -1.58) (pol 16.53 -26.27 -1.95)) (L (pol 16.52 -26.24 -1.94) (pol 15.44 -28.34 -2.03)) (L (pol 15.42 -28.55 -1.86) (pol 14.92 -32.55 -1.98)) (L (pol 14.90 -32.54 -2.25) (pol 15.26 -37.08 -1.89)) (L (pol 15.28 -37.21 -2.06) (pol 16.31 -39.67 -1.78)) (L (pol 16.28 -39.55 -1.64) (pol 17.54 -39.17 -1.67)) (L (pol 17.55 -39.31 -1.67) (pol 18.51 -36.89 -1.61)) (L (pol 18.55 -36.88 -1.69) (pol 18.93 -33.46 -1.78)) (L (pol 18.93 -33.32 -1.51) (pol 18.64 -29.59 -1.54)))(HJ (n raj1) (ax 0.00))(HJ (n raj2) (ax 0.00))(HJ (n raj3) (ax 0.00))(HJ (n raj4) (ax 0.00))(HJ (n laj1) (ax 0.00))(HJ (n laj2) (ax -0.00))(HJ (n laj3) (ax 0.00))(HJ (n laj4) (ax -0.00))(HJ (n rlj1) (ax 0.00))(HJ (n rlj2) (ax -0.00))(HJ (n rlj3) (ax -0.00))(HJ (n rlj4) (ax -0.00))(HJ (n rlj5) (ax -0.00))(HJ (n rlj6) (ax -0.00))(HJ (n llj1) (ax 0.00))(HJ (n llj2) (ax 0.00))(HJ (n llj3) (ax -0.00))(HJ (n llj4) (ax -0.00))(HJ (n llj5) (ax -0.00))(HJ (n llj6) (ax 0.00))";
-int size = 1836;
+///< Confere cada consulta do StructuralIndex contra uma busca byte a byte
+bool
+check_structural_index(std::string_view msg){
+    StructuralIndex index;
+    index.build(msg);
 
-const char* example1 = "(time (now 104.87))(GS (t 0.00) (pm BeforeKickOff))(GYR (n torso)(rt 0.24 -0.05 0.02))(ACC (n torso) (a -0.01 0.05 9.80))(HJ (n hj1)(ax -0.00))(HJ (n hj2) (ax -0.00))(See (G2R (pol 20.11 -18.92 0.84))(G1R (pol 19.53 -13.04 0.90)) (F1R (pol 19.08 4.58 -1.54)) (F2R (pol 22.73 -33.49 -1.47)) (B (pol 10.12 -33.09 -2.94)) (L (pol 15.13 -55.78 -2.03) (pol 8.67 10.24 -3.34)) (L (pol 22.78 -33.20 -1.23)(pol 19.05 4.32 -1.76)) (L (pol 19.08 4.57 -1.55) (pol 1.81 60.14 -17.11)) (L (pol 22.77 -33.23 -1.26) (pol 14.49 -59.60 -1.79)) (L (pol 17.56 -11.77 -1.83) (pol 18.76 -23.38 -1.60)) (L (pol 17.58 -11.67 -1.74) (pol 19.35 -10.53 -1.53)) (L (pol 18.71 -23.82 -1.97)(pol 20.43 -21.36 -1.45)) (L (pol 11.68 -28.23 -2.73) (pol 10.93 -23.90 -2.69)) (L (pol 10.91 -24.22 -2.95) (pol 9.84 -22.59 -3.02)) (L (pol 9.84 -22.64 -3.06) (pol 8.81 -25.74 -3.68)) (L (pol 8.83 -25.33 -3.34) (pol 8.35 -32.24 -3.68)) (L (pol 8.35 -32.20 -3.64)(pol 8.69 -39.32 -3.48)) (L (pol 8.68 -39.59 -3.71) (pol 9.63 -43.18 -3.37)) (L (pol 9.65 -42.85 -3.10) (pol 10.75 -42.17 -2.80)) (L (pol 10.75 -42.28 -2.89) (pol 11.61 -38.36 -2.50)) (L (pol 11.62 -38.15 -2.33) (pol 11.94 -33.38 -2.58)) (L (pol 11.94 -33.31 -2.52) (pol 11.70 -28.03 -2.56))))(HJ (n raj1) (ax -0.00))(HJ (n raj2) (ax 0.00))(HJ (n raj3) (ax 0.00))(HJ (n raj4) (ax 0.00))(HJ (n laj1) (ax -0.01))(HJ (n laj2) (ax 0.00))(HJ (n laj3) (ax -0.00))(HJ (n laj4) (ax -0.00))(HJ (n rlj1) (ax 0.01))(HJ (n rlj2) (ax 0.00))(HJ (n rlj3) (ax 0.01))(HJ (n rlj4) (ax -0.00))(HJ (n rlj5) (ax 0.00))(FRP (n rf) (c -0.02 -0.00 -0.02) (f -0.02 -0.17 22.52))(HJ (n rlj6) (ax -0.00))(HJ (n llj1) (ax -0.01))(HJ (n llj2) (ax 0.01))(HJ (n llj3) (ax 0.00))(HJ (n llj4) (ax -0.00))(HJ (n llj5) (ax 0.00))(FRP (n lf) (c 0.02 -0.01 -0.01) (f -0.08 -0.20 22.63))(HJ (n llj6) (ax 0.00))";
-int size1 = 1797;
+    auto naive = [&msg](size_t pos, auto is_target){
+        while(pos < msg.size() && !is_target(msg[pos])){ pos++; }
+        return pos;
+    };
+
+    for(size_t pos = 0; pos <= msg.size(); pos++){
+        if(index.next_open(pos)      != naive(pos, [](char c){ return c == '('; })){ return False; }
+        if(index.next_delimiter(pos) != naive(pos, [](char c){ return c == ' ' || c == ')'; })){ return False; }
+        if(index.next_paren(pos)     != naive(pos, [](char c){ return c == '(' || c == ')'; })){ return False; }
+        if(index.next_token(pos)     != naive(pos, [](char c){ return c != ' ' && c != '(' && c != ')'; })){ return False; }
+    }
+    return True;
+}
+
+///< Confere parse_server_float contra std::from_chars (bit a bit) nos formatos do servidor e em casos atípicos
+bool
+check_fast_float(){
+    auto same = [](const std::string& text){
+        float a = 0.0f, b = 0.0f;
+        bool ok_a = std::from_chars(text.data(), text.data() + text.size(), a).ec == std::errc{};
+        bool ok_b = parse_server_float(text.data(), text.data() + text.size(), b);
+        return ok_a == ok_b && (!ok_a || std::memcmp(&a, &b, sizeof(float)) == 0);
+    };
+
+    // Todos os valores de -9999.99 a 9999.99 com 2 casas, e alguns com 1 a 6 casas
+    char text[32];
+    for(int i = -999999; i <= 999999; i++){
+        std::snprintf(text, sizeof(text), "%s%d.%02d", (i < 0) ? "-" : "", std::abs(i) / 100, std::abs(i) % 100);
+        if(!same(text)){ return False; }
+    }
+    for(int decimals = 1; decimals <= 6; decimals++){
+        for(int i = -200000; i <= 200000; i += 7){
+            std::snprintf(text, sizeof(text), "%.*f", decimals, i * 0.000123);
+            if(!same(text)){ return False; }
+        }
+    }
+    for(const char* odd : {"0", "-0", "-0.00", "5.", "12345678.9", "1e3", "-2.5e-3", "0.000000001", "nan", "inf", "-", ".", "", "abc"}){
+        if(!same(odd)){ return False; }
+    }
+    return True;
+}
+
+///< Confere que cada tabela de hash perfeito devolve o índice de suas chaves e rejeita as demais
+template<typename Table, ::size_t N>
+bool
+check_perfect_hash(const Table& table, const std::array<std::string_view, N>& names){
+    for(::size_t i = 0; i < N; i++){
+        if(table.find(names[i]) != int(i)){ return False; }
+    }
+    for(std::string_view other : {"", "x", "hj", "hj3", "F3L", "GSS", "tim", "u", "Play0n", "kickoff_left"}){
+        if(table.find(other) != -1){ return False; }
+    }
+    return True;
+}
+
+///< Confere os valores que o parser grava a partir das tags
+bool
+check_tag_dispatch(){
+    Environment env(Logger::get());
+    env.update_from_server(SAMPLE_MESSAGE_FULL_GS);
+    if(!env.is_left || env.unum != 1 || env.goals_scored != 3 || env.goals_conceded != 2){ return False; }
+    if(env.time_match != 5.12f || env.current_mode != Environment::PlayMode::BEFORE_KICKOFF){ return False; }
+    if(env.loc.list_landmark[size_t(SeeTag::F1R)].sph_position[0] != 29.27f){ return False; }
+
+    env.update_from_server("(GS (team left) (pm KickOff_Left))(HJ (n raj2) (ax -12.50))");
+    if(env.current_mode != Environment::PlayMode::OUR_KICKOFF || env.world.joint_angle[3] != -12.5f){ return False; }
+    env.update_from_server("(GS (team right) (pm KickOff_Left))");
+    return env.current_mode == Environment::PlayMode::THEIR_KICKOFF;
+}
+
+///< Confere o WorldState preenchido a partir das mensagens de exemplo
+bool
+check_world_state(){
+    Environment env(Logger::get());
+    const WorldState& world = env.world;
+
+    env.update_from_server(SAMPLE_MESSAGE_FULL_GS);
+    if(world.gyro[0] != 0.01f || world.acc[2] != 0.01f){ return False; }
+    if(!world.ball_visible || world.ball_polar[0] != 16.91f || world.ball_polar[1] != -32.71f){ return False; }
+    if(world.player_count != 1 || world.player_id[0] != 1 || !world.player_teammate[0]){ return False; }
+    if(world.player_parts[0] != 0b110 || world.body[1].distance[0] != 0.18f || world.body[2].horizontal[0] != 36.49f){ return False; }
+    if(world.line_count != 17 || world.line_start.distance[0] != 23.88f || world.line_end.vertical[0] != -2.23f){ return False; }
+    if(world.foot_touching[0] || world.foot_touching[1]){ return False; }
+
+    env.update_from_server(SAMPLE_MESSAGE_FRP);
+    if(world.player_count != 0 || world.line_count != 17 || world.ball_polar[0] != 10.12f){ return False; }
+    if(!world.foot_touching[0] || !world.foot_touching[1]){ return False; }
+    if(world.foot_contact[1][0] != -0.02f || world.foot_force[1][2] != 22.52f || world.foot_force[0][2] != 22.63f){ return False; }
+
+    // Velocidade das juntas derivada entre dois ciclos (0.02 s)
+    env.update_from_server("(time (now 1.00))(HJ (n rlj3) (ax 10.00))");
+    env.update_from_server("(time (now 1.02))(HJ (n rlj3) (ax 11.00))");
+    return std::abs(world.joint_speed[12] - 50.0f) < 1e-2f && world.joint_speed[0] == 0.0f;
+}
+
+///< Blocos fora de `interests` são pulados sem alterar os demais
+bool
+check_tag_mask(){
+    Environment full(Logger::get()), motion(Logger::get()), keeper(Logger::get());
+    motion.interests = MOTION_TAGS;
+    keeper.interests = NO_LINE_TAGS;
+    for(std::string_view msg : SAMPLE_MESSAGES){
+        full.update_from_server(msg);
+        motion.update_from_server(msg);
+        keeper.update_from_server(msg);
+
+        if(motion.time_server != full.time_server || motion.world.joint_angle != full.world.joint_angle){ return False; }
+        if(motion.world.gyro != full.world.gyro || motion.world.foot_force != full.world.foot_force){ return False; }
+        if(motion.world.line_count != 0 || motion.world.player_count != 0 || motion.world.ball_visible || !motion.loc.visibles_landmarks.empty()){ return False; }
+
+        if(keeper.world.line_count != 0 || keeper.unum != full.unum || keeper.world.player_count != full.world.player_count){ return False; }
+        if(keeper.world.ball_polar != full.world.ball_polar || keeper.world.body[1].distance != full.world.body[1].distance){ return False; }
+    }
+    return full.world.line_count == 17;
+}
+
+///< Codificação de ida e volta, rejeição de ruído e alimentação do TeamKnowledge pelo 'hear'
+bool
+check_team_message(){
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> x(-15.0f, 15.0f), y(-10.0f, 10.0f);
+    for(int i = 0; i < 100000; i++){
+        TeamMessage sent{uint8_t(1 + i % 11), TeamIntent(i % int(TeamIntent::COUNT)), (i & 1) == 1, {x(rng), y(rng)}, {x(rng), y(rng)}};
+        TeamMessageText text = encode_team_message(sent);
+        for(char c : text.chars){ if(c <= ' ' || c > '~' || c == '(' || c == ')'){ return False; } }
+
+        TeamMessage heard;
+        if(!decode_team_message(text.view(), heard)){ return False; }
+        if(heard.unum != sent.unum || heard.intent != sent.intent || heard.ball_seen != sent.ball_seen){ return False; }
+        for(int k = 0; k < 2; k++){
+            if(std::abs(heard.ball[k] - sent.ball[k]) > 0.005f || std::abs(heard.position[k] - sent.position[k]) > 0.005f){ return False; }
+        }
+    }
+
+    // Trocar um caractere quase sempre invalida a mensagem (7 bits de verificação)
+    TeamMessageText text = encode_team_message(TeamMessage{7, TeamIntent::PASS, True, {3.0f, -2.0f}, {1.0f, 1.0f}});
+    int accepted = 0, total = 0;
+    for(size_t i = 0; i < TEAM_MESSAGE_SIZE; i++){
+        for(char c : TEAM_MESSAGE_ALPHABET){
+            if(c == text.chars[i]){ continue; }
+            std::string corrupted(text.view());
+            corrupted[i] = c;
+            TeamMessage heard;
+            accepted += decode_team_message(corrupted, heard);
+            total++;
+        }
+    }
+    if(accepted * 50 > total){ return False; }
+    TeamMessage ignored;
+    if(decode_team_message("abc", ignored) || decode_team_message("~~~~~~~~~~", ignored)){ return False; }
+
+    Environment env(Logger::get());
+    std::string msg = "(time (now 1.00))";
+    msg += "(hear " + std::string(TEAM_NAME) + " 12.30 -45.50 " + std::string(text.view()) + ")";
+    msg += "(hear Adversario 12.30 10.00 " + std::string(encode_team_message(TeamMessage{3, TeamIntent::SHOOT}).view()) + ")";
+    msg += "(hear 12.32 self " + std::string(encode_team_message(TeamMessage{1, TeamIntent::DEFEND, False, {}, {-14.0f, 0.0f}}).view()) + ")";
+    msg += "(hear " + std::string(TEAM_NAME) + " 12.32 20.00 ruido)";
+    env.update_from_server(msg);
+
+    const TeamKnowledge& team = env.world.team;
+    const TeamKnowledge::Report* passer = team.fresh(7, 12.32f, 0.5f);
+    const TeamKnowledge::Report* self = team.fresh(1, 12.32f, 0.5f);
+    std::array<float, 2> ball{};
+    if(!passer || passer->direction != -45.5f || passer->self || passer->message.intent != TeamIntent::PASS){ return False; }
+    if(!self || !self->self || self->heard_at != 12.32f || self->message.intent != TeamIntent::DEFEND){ return False; }
+    if(team.fresh(3, 12.32f, 0.5f) || team.fresh(7, 20.0f, 0.5f) || team.received != 2 || team.rejected != 1){ return False; }
+    return team.ball(12.32f, 0.5f, ball) && std::abs(ball[0] - 3.0f) < 0.005f && std::abs(ball[1] + 2.0f) < 0.005f;
+}
 
 int
 main(){
 
-    std::string_view message_from_server(example1, size1);
+    bool tables = check_perfect_hash(SERVER_TAGS, SERVER_TAG_NAMES) && check_perfect_hash(GAME_STATE_TAGS, GAME_STATE_TAG_NAMES)
+               && check_perfect_hash(SEE_TAGS, SEE_TAG_NAMES) && check_perfect_hash(PLAYER_TAGS, PLAYER_TAG_NAMES)
+               && check_perfect_hash(JOINTS, JOINT_NAMES) && check_perfect_hash(PLAY_MODES, PLAY_MODE_NAMES);
+    std::cout << "PerfectHash (tags, juntas e modos de jogo): " << (tables ? "OK" : "FALHOU") << std::endl;
+    std::cout << "Despacho por tags: " << (check_tag_dispatch() ? "OK" : "FALHOU") << std::endl;
+    std::cout << "WorldState: " << (check_world_state() ? "OK" : "FALHOU") << std::endl;
+    std::cout << "Mascara de tags: " << (check_tag_mask() ? "OK" : "FALHOU") << std::endl;
+    std::cout << "Mensagens do time (say/hear): " << (check_team_message() ? "OK" : "FALHOU") << std::endl;
+
+    std::cout << "parse_server_float x from_chars: " << (check_fast_float() ? "OK" : "FALHOU") << std::endl;
+
+    for(std::string_view msg : SAMPLE_MESSAGES){
+        std::cout << "StructuralIndex (" << StructuralIndex::BACKEND << "): "
+                  << (check_structural_index(msg) ? "OK" : "FALHOU") << std::endl;
+    }
+
+    std::string_view message_from_server = SAMPLE_MESSAGE_FRP;
     Environment ex = Environment(Logger::get());
     ex.update_from_server(message_from_server);
 
     return 0;
-}
\ No newline at end of file
+}
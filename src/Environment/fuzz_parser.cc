@@ -0,0 +1,159 @@
+#include "Environment.hpp"
+#include "sample_messages.hpp"
+#include "../Communication/FrameRecorder.hpp"
+#include "../Utils/MockServer/MockServer.hpp"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <memory>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <unistd.h>
+#include <fcntl.h>
+
+/**
+ * Fuzzing do parser (Environment::update_from_server) com entradas truncadas e malformadas.
+ *
+ * Uso: ./a.out [iterações] [semente] [captura]
+ *   Cada iteração parte de uma mensagem do corpus (amostras, percepções geradas e, se informada,
+ *   uma captura) e aplica mutações aleatórias: truncamento, troca de bytes, remoção e duplicação
+ *   de trechos, rajadas de parênteses e junção de mensagens. O parser lê uma cópia da entrada seguida
+ *   de PADDING bytes de sentinela (Environment::__padded); sob AddressSanitizer, o restante desse buffer
+ *   é envenenado a cada mensagem, de modo que qualquer leitura além das sentinelas seja acusada.
+ *
+ * Compile com -fsanitize=address,undefined (ver `make fuzz`). Em caso de falha (sinal ou
+ * travamento por mais de 10 s), a entrada atual é gravada em `fuzz_crash.bin`.
+ *
+ * Com -DLIBFUZZER, apenas `LLVMFuzzerTestOneInput` é definida (clang -fsanitize=fuzzer).
+ */
+
+static Environment& fuzz_environment(){
+    static Environment env(Logger::get());
+    return env;
+}
+
+///< Interpreta uma entrada arbitrária a partir de um bloco do tamanho exato
+static void
+parse_input(const char* data, size_t size){
+    std::unique_ptr<char[]> exact(new char[size ? size : 1]);
+    std::memcpy(exact.get(), data, size);
+
+    Environment& env = fuzz_environment();
+    env.update_from_server(std::string_view(exact.get(), size));
+    env.loc.visibles_landmarks.clear();
+}
+
+#ifdef LIBFUZZER
+
+extern "C" int
+LLVMFuzzerTestOneInput(const uint8_t* data, size_t size){
+    parse_input(reinterpret_cast<const char*>(data), size);
+    return 0;
+}
+
+#else
+
+static std::string current;  ///< Entrada em interpretação (gravada em caso de falha)
+
+///< Grava a entrada atual e encerra (somente funções seguras para sinais)
+static void
+on_failure(int signal){
+    int fd = ::open("fuzz_crash.bin", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd >= 0){ (void)!::write(fd, current.data(), current.size()); ::close(fd); }
+    const char note[] = "\n[fuzz] Falha: entrada gravada em fuzz_crash.bin\n";
+    (void)!::write(2, note, sizeof(note) - 1);
+    ::_exit(128 + signal);
+}
+
+/**
+ * @brief Aplica de 1 a 8 mutações aleatórias.
+ */
+static void
+mutate(std::string& msg, const std::vector<std::string>& corpus, std::mt19937& rng){
+    static constexpr char INTERESTING[] = " ()()-.0123456789eE+naif\0\xff";
+    auto pick = [&rng](size_t n){ return n ? size_t(rng() % n) : 0; };
+
+    int mutations = 1 + int(rng() % 8);
+    for(int m = 0; m < mutations; m++){
+        switch(rng() % 8){
+            case 0: msg.resize(pick(msg.size() + 1)); break;                                   // Truncamento
+            case 1: if(!msg.empty()){ msg[pick(msg.size())] = char(rng()); } break;             // Byte qualquer
+            case 2: if(!msg.empty()){ msg[pick(msg.size())] = INTERESTING[pick(sizeof(INTERESTING) - 1)]; } break;
+            case 3: {                                                                           // Remoção de trecho
+                size_t at = pick(msg.size() + 1);
+                msg.erase(at, pick(64));
+                break;
+            }
+            case 4: {                                                                           // Duplicação de trecho
+                size_t at = pick(msg.size() + 1);
+                std::string piece = msg.substr(at, pick(64));
+                msg.insert(pick(msg.size() + 1), piece);
+                break;
+            }
+            case 5: msg.insert(pick(msg.size() + 1), pick(300), (rng() & 1) ? '(' : ')'); break; // Rajada de parênteses
+            case 6: {                                                                           // Junção com outra mensagem
+                const std::string& other = corpus[pick(corpus.size())];
+                msg = msg.substr(0, pick(msg.size() + 1)) + other.substr(pick(other.size() + 1));
+                break;
+            }
+            case 7: {                                                                           // Token numérico longo
+                std::string number(pick(400), '9');
+                msg.insert(pick(msg.size() + 1), number);
+                break;
+            }
+        }
+    }
+}
+
+int
+main(int argc, char** argv){
+
+    size_t iterations = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    uint32_t seed = (argc > 2) ? uint32_t(std::strtoul(argv[2], nullptr, 10)) : 1;
+
+    std::vector<std::string> corpus;
+    for(std::string_view msg : SAMPLE_MESSAGES){ corpus.emplace_back(msg); }
+
+    PerceptionGenerator generator(seed);
+    for(int i = 0; i < 64; i++){
+        corpus.emplace_back(generator.build(0.02f * i, 0.02f * i, i % 12, "PlayOn", i % 3 == 0, i % 23, i % 4));
+    }
+
+    if(argc > 3){
+        FrameReplayer replayer;
+        if(!replayer.open(argv[3])){ std::fprintf(stderr, "Captura invalida: %s\n", argv[3]); return 1; }
+        replayer.replay([&corpus](int, std::string_view frame){ corpus.emplace_back(frame); });
+    }
+
+    for(int sig : {SIGSEGV, SIGBUS, SIGABRT, SIGFPE, SIGILL, SIGALRM}){ std::signal(sig, on_failure); }
+
+    std::mt19937 rng(seed);
+    size_t bytes = 0;
+    for(size_t i = 0; i < iterations; i++){
+        if(i % 1024 == 0){ ::alarm(10); } // Um laço infinito no parser dispara o SIGALRM
+
+        current = corpus[rng() % corpus.size()];
+        mutate(current, corpus, rng);
+        bytes += current.size();
+        parse_input(current.data(), current.size());
+
+        if((i + 1) % 50000 == 0){ std::printf("[fuzz] %zu entradas...\n", i + 1); std::fflush(stdout); }
+    }
+    ::alarm(0);
+
+    // As mensagens originais continuam sendo interpretadas corretamente depois do fuzzing
+    Environment& env = fuzz_environment();
+    env.update_from_server(SAMPLE_MESSAGE_FULL_GS);
+    bool intact = env.unum == 1 && env.goals_scored == 3 && env.world.line_count == 17;
+
+    std::printf(
+        "[fuzz] %zu entradas (%.1f MB), semente %u: nenhuma falha | parser intacto: %s\n",
+        iterations, double(bytes) / 1e6, seed, intact ? "OK" : "FALHOU"
+    );
+    return intact ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,171 @@
+#include "Environment.hpp"
+#include "sample_messages.hpp"
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * Teste de estresse da publicação de snapshots (SeqlockSnapshot): um escritor, vários leitores.
+ *
+ * Uso: ./a.out [leitores] [segundos]
+ *
+ * 1. Sintético: o escritor publica snapshots em que todos os campos valem o mesmo contador `k`;
+ *    um leitor que observe dois valores diferentes em uma mesma cópia encontrou uma leitura rasgada.
+ * 2. Environment real: o escritor interpreta as mensagens de exemplo alternadamente e os leitores
+ *    usam read_snapshot; cada cópia deve ser idêntica a uma das duas percepções esperadas.
+ */
+
+static std::atomic<bool> writing{True};
+
+///< Preenche todos os campos numéricos com `k`
+static void
+fill_with(WorldSnapshot& s, uint64_t k){
+    k %= 1000000; // Exato em float
+    float value = float(k);
+    s.time_server = value;
+    s.time_match = value;
+    s.unum = uint8_t(k);
+    s.world.line_count = uint8_t(k % (WorldState::MAX_LINES + 1));
+    s.world.joint_angle.fill(value);
+    s.world.joint_speed.fill(value);
+    s.world.line_start.distance.fill(value);
+    s.world.line_end.vertical.fill(value);
+    s.world.body[WorldState::BODY_PARTS - 1].horizontal.fill(value);
+}
+
+///< Confere que uma cópia veio inteira de uma única publicação
+static bool
+consistent(const WorldSnapshot& s){
+    float value = s.time_server;
+    uint64_t k = uint64_t(value);
+    if(s.time_match != value || s.unum != uint8_t(k) || s.world.line_count != uint8_t(k % (WorldState::MAX_LINES + 1))){ return False; }
+    for(float v : s.world.joint_angle){ if(v != value){ return False; } }
+    for(float v : s.world.joint_speed){ if(v != value){ return False; } }
+    for(float v : s.world.line_start.distance){ if(v != value){ return False; } }
+    for(float v : s.world.line_end.vertical){ if(v != value){ return False; } }
+    for(float v : s.world.body[WorldState::BODY_PARTS - 1].horizontal){ if(v != value){ return False; } }
+    return True;
+}
+
+///< Compara os campos que as mensagens de exemplo preenchem
+static bool
+same_percept(const WorldSnapshot& a, const WorldSnapshot& b){
+    if(a.time_server != b.time_server || a.time_match != b.time_match || a.unum != b.unum){ return False; }
+    if(a.world.ball_polar != b.world.ball_polar || a.world.player_count != b.world.player_count || a.world.line_count != b.world.line_count){ return False; }
+    if(a.world.joint_angle != b.world.joint_angle || a.world.joint_speed != b.world.joint_speed){ return False; }
+    if(a.world.foot_force != b.world.foot_force || a.world.gyro != b.world.gyro){ return False; }
+    for(size_t i = 0; i < a.world.line_count; i++){
+        if(a.world.line_start.distance[i] != b.world.line_start.distance[i] || a.world.line_end.vertical[i] != b.world.line_end.vertical[i]){ return False; }
+    }
+    return True;
+}
+
+struct ReaderStats {
+    uint64_t reads = 0;
+    uint64_t retries = 0;
+    uint64_t max_retries = 0;
+    uint64_t torn = 0;
+    uint64_t regressions = 0; ///< Versão lida menor que a anterior
+};
+
+///< Lê continuamente até `writing` ser desligado
+template<typename Read>
+static ReaderStats
+reader_loop(Read&& read){
+    ReaderStats stats;
+    thread_local WorldSnapshot snapshot;
+    uint64_t last = 0;
+    while(writing.load(std::memory_order_relaxed)){
+        uint64_t retries = 0;
+        int verdict = read(snapshot, retries, last);
+        stats.reads++;
+        stats.retries += retries;
+        stats.max_retries = std::max(stats.max_retries, retries);
+        stats.torn += (verdict == 1);
+        stats.regressions += (verdict == 2);
+    }
+    return stats;
+}
+
+///< Um escritor (esta thread) e `readers` leitores por `seconds` segundos
+template<typename Writer, typename Read>
+static bool
+scenario(const char* name, int readers, double seconds, Writer&& writer, Read&& read){
+    writing = True;
+    std::vector<ReaderStats> stats(readers);
+    std::vector<std::thread> threads;
+    for(int r = 0; r < readers; r++){
+        threads.emplace_back([&stats, &read, r](){ stats[r] = reader_loop(read); });
+    }
+
+    uint64_t publications = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    while(std::chrono::steady_clock::now() < deadline){
+        for(int i = 0; i < 256; i++){ writer(++publications); }
+    }
+    writing = False;
+    for(auto& t : threads){ t.join(); }
+
+    ReaderStats total;
+    for(const auto& s : stats){
+        total.reads += s.reads; total.retries += s.retries; total.torn += s.torn; total.regressions += s.regressions;
+        total.max_retries = std::max(total.max_retries, s.max_retries);
+    }
+    bool ok = total.torn == 0 && total.regressions == 0;
+    std::printf(
+        "[%-11s] %d leitores | %llu publicacoes | %llu leituras | %llu releituras (max %llu) | %llu rasgadas | %llu regressoes -> %s\n",
+        name, readers, (unsigned long long)publications, (unsigned long long)total.reads,
+        (unsigned long long)total.retries, (unsigned long long)total.max_retries,
+        (unsigned long long)total.torn, (unsigned long long)total.regressions, ok ? "OK" : "FALHOU"
+    );
+    return ok;
+}
+
+int
+main(int argc, char** argv){
+
+    int readers = (argc > 1) ? std::atoi(argv[1]) : 4;
+    double seconds = (argc > 2) ? std::atof(argv[2]) : 2.0;
+
+    // 1. Sintético
+    SeqlockSnapshot<WorldSnapshot> seqlock;
+    bool ok = scenario("sintetico", readers, seconds,
+        [&seqlock](uint64_t k){ seqlock.publish_with([k](WorldSnapshot& s){ fill_with(s, k); }); },
+        [&seqlock](WorldSnapshot& s, uint64_t& retries, uint64_t& last){
+            uint64_t version = seqlock.read(s, &retries);
+            int verdict = (version < last) ? 2 : (version > 0 && !consistent(s)) ? 1 : 0;
+            last = version;
+            return verdict;
+        }
+    );
+
+    // 2. Environment real: percepções esperadas após o regime alternado se estabilizar
+    std::string_view messages[2] = {SAMPLE_MESSAGE_FULL_GS, SAMPLE_MESSAGE_FRP};
+    static WorldSnapshot expected[2];
+    {
+        Environment reference(Logger::get());
+        for(int i = 0; i < 4; i++){
+            reference.update_from_server(messages[i % 2]);
+            if(i >= 2){ reference.read_snapshot(expected[i % 2]); }
+        }
+    }
+
+    Environment env(Logger::get());
+    for(int i = 0; i < 2; i++){ env.update_from_server(messages[i]); }
+    ok &= scenario("Environment", readers, seconds,
+        [&env, &messages](uint64_t k){ env.update_from_server(messages[k % 2]); env.loc.visibles_landmarks.clear(); },
+        [&env](WorldSnapshot& s, uint64_t& retries, uint64_t& last){
+            uint64_t version = env.read_snapshot(s);
+            retries = 0;
+            int verdict = (version < last) ? 2 : (!same_percept(s, expected[0]) && !same_percept(s, expected[1])) ? 1 : 0;
+            last = version;
+            return verdict;
+        }
+    );
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+/**
+ * Contadores para benchmarks: instruções executadas (perf_event) e alocações no heap.
+ *
+ * Atenção: este header substitui os operadores globais `new`/`delete` para contar alocações.
+ * Inclua-o em exatamente um arquivo de um programa de benchmark, nunca no código do time.
+ */
+
+#include "../../Booting/booting_templates.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// --- Bibliotecas de Sistema (Linux) ---
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * @class InstructionCounter
+ * @brief Instruções executadas em modo usuário pela thread atual (PERF_COUNT_HW_INSTRUCTIONS).
+ * @details Indisponível em máquinas virtuais sem PMU ou com `perf_event_paranoid` restritivo:
+ * nesse caso `available()` é False e as medidas devem ser reportadas como ausentes.
+ */
+class InstructionCounter {
+private:
+    int __fd = -1;
+
+public:
+    InstructionCounter() {
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        this->__fd = int(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    ~InstructionCounter() { if(this->__fd >= 0){ ::close(this->__fd); } }
+
+    InstructionCounter(const InstructionCounter&) = delete;
+    InstructionCounter& operator=(const InstructionCounter&) = delete;
+
+    bool available() const { return this->__fd >= 0; }
+
+    /**
+     * @brief Zera e inicia a contagem.
+     */
+    void start() {
+        if(this->__fd < 0){ return; }
+        ::ioctl(this->__fd, PERF_EVENT_IOC_RESET, 0);
+        ::ioctl(this->__fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    /**
+     * @brief Encerra a contagem.
+     * @return Instruções desde `start()` (0 se indisponível).
+     */
+    uint64_t stop() {
+        if(this->__fd < 0){ return 0; }
+        ::ioctl(this->__fd, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t count = 0;
+        if(::read(this->__fd, &count, sizeof(count)) != ssize_t(sizeof(count))){ return 0; }
+        return count;
+    }
+};
+
+///< Quantidade de alocações feitas pelo programa (todas as threads)
+inline std::atomic<uint64_t> allocation_count{0};
+
+// --- Substituição dos operadores globais de alocação ---
+
+/**
+ * @brief Alocação contada: o único ponto de entrada de todos os `operator new` abaixo.
+ * @param alignment 0 para o alinhamento padrão (`malloc`), ou o alinhamento pedido (`aligned_alloc`).
+ */
+[[gnu::noinline]] inline void* counted_allocate(std::size_t size, std::size_t alignment) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if(alignment == 0){ return std::malloc(size ? size : 1); }
+    std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+    return std::aligned_alloc(alignment, rounded ? rounded : alignment);
+}
+
+/**
+ * @brief Liberação correspondente a `counted_allocate`: o único ponto de saída de todos os `operator delete`.
+ * @details Memória de `aligned_alloc` é liberada com `free`, como a de `malloc` (C11 7.22.3): por isso
+ * as variantes alinhadas de delete não precisam de uma função própria. As duas funções não são
+ * expandidas inline de propósito: vendo um `free` aplicado ao resultado de `operator new`,
+ * o GCC acusaria -Wmismatched-new-delete, embora o par seja consistente.
+ */
+[[gnu::noinline]] inline void counted_release(void* p) noexcept { std::free(p); }
+
+void* operator new(std::size_t size) {
+    if(void* p = counted_allocate(size, 0)){ return p; }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    if(void* p = counted_allocate(size, std::size_t(align))){ return p; }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) { return ::operator new(size, align); }
+
+void operator delete(void* p) noexcept { counted_release(p); }
+void operator delete[](void* p) noexcept { counted_release(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_release(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_release(p); }
+void operator delete(void* p, std::align_val_t) noexcept { counted_release(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { counted_release(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { counted_release(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { counted_release(p); }
@@ -0,0 +1,472 @@
+#pragma once
+
+#include "../../Booting/booting_templates.hpp"
+#include "../../Communication/FrameDecoder.hpp"
+#include "../../Communication/Poller.hpp"
+#include "../../Environment/TeamMessage.hpp"
+
+// --- Bibliotecas da Standard Library ---
+#include <vector>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <iostream>
+
+// --- Bibliotecas de Sistema (POSIX) ---
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <arpa/inet.h>
+#include <netinet/tcp.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+/**
+ * @class PerceptionGenerator
+ * @brief Gera mensagens de percepção no formato do rcssserver3d.
+ * @details Segue a estrutura dos exemplos de Environment/debug.cc: time, GS, GYR, ACC,
+ * 22 juntas (HJ), sensores de força (FRP) e, a cada 3 ciclos como no servidor real, a visão (See)
+ * com landmarks, bola, jogadores e linhas. Os valores recebem ruído para não serem constantes.
+ */
+class PerceptionGenerator {
+private:
+    std::string __buffer;   ///< Mensagem em construção (reservada uma vez)
+    std::mt19937 __rng;
+    std::uniform_real_distribution<float> __noise{-1.0f, 1.0f};
+
+    /**
+     * @brief Acrescenta texto formatado ao final da mensagem.
+     */
+    template<typename... Args>
+    void __put(const char* fmt, Args... args) {
+        char tmp[256];
+        int n = std::snprintf(tmp, sizeof(tmp), fmt, args...);
+        this->__buffer.append(tmp, size_t(n));
+    }
+
+    /**
+     * @brief Valor base acrescido de ruído uniforme de amplitude `amp`.
+     */
+    float __jitter(float base, float amp) { return base + amp * this->__noise(this->__rng); }
+
+    /**
+     * @brief Coordenadas polares (distância, ângulo horizontal, ângulo vertical) com ruído.
+     */
+    void __pol(float r, float h, float v) {
+        this->__put("(pol %.2f %.2f %.2f)", this->__jitter(r, 0.05f), this->__jitter(h, 0.5f), this->__jitter(v, 0.2f));
+    }
+
+public:
+    /**
+     * @brief Nomes das 22 juntas na ordem em que o servidor as envia.
+     */
+    static constexpr const char* JOINTS[22] = {
+        "hj1", "hj2",
+        "raj1", "raj2", "raj3", "raj4",
+        "laj1", "laj2", "laj3", "laj4",
+        "rlj1", "rlj2", "rlj3", "rlj4", "rlj5", "rlj6",
+        "llj1", "llj2", "llj3", "llj4", "llj5", "llj6"
+    };
+
+    explicit PerceptionGenerator(uint32_t seed = 42) : __rng(seed) { this->__buffer.reserve(8192); }
+
+    /**
+     * @brief Monta uma mensagem de percepção completa.
+     * @param time_server Tempo do servidor (tag 'time').
+     * @param time_match Tempo de partida (tag 'GS').
+     * @param unum Número do agente destinatário (0 antes do init).
+     * @param play_mode Modo de jogo enviado em 'pm'.
+     * @param with_vision Inclui o bloco 'See'.
+     * @param players Quantidade de jogadores vistos no bloco 'See'.
+     * @param hears Quantidade de mensagens 'hear' (a primeira do próprio agente, as demais de companheiros).
+     * @return View para a mensagem (válida até a próxima chamada).
+     */
+    std::string_view
+    build(float time_server, float time_match, int unum, const char* play_mode, bool with_vision, int players = 2, int hears = 0){
+        this->__buffer.clear();
+
+        this->__put("(time (now %.2f))", time_server);
+        if(unum > 0){ this->__put("(GS (unum %d) (team left) (t %.2f) (pm %s))", unum, time_match, play_mode); }
+        else        { this->__put("(GS (t %.2f) (pm %s))", time_match, play_mode); }
+        this->__put("(GYR (n torso) (rt %.2f %.2f %.2f))", this->__jitter(0, 0.3f), this->__jitter(0, 0.3f), this->__jitter(0, 0.3f));
+        this->__put("(ACC (n torso) (a %.2f %.2f %.2f))", this->__jitter(0, 0.05f), this->__jitter(0, 0.05f), this->__jitter(9.81f, 0.05f));
+
+        // Mensagens dos agentes no formato do time (ver TeamMessage.hpp)
+        for(int h = 0; h < hears; h++){
+            TeamMessage message;
+            message.unum = uint8_t(h == 0 && unum > 0 ? unum : 1 + h % 11);
+            message.intent = TeamIntent(h % int(TeamIntent::COUNT));
+            message.ball_seen = True;
+            message.ball = {this->__jitter(0, 14.0f), this->__jitter(0, 9.0f)};
+            message.position = {this->__jitter(0, 14.0f), this->__jitter(0, 9.0f)};
+            TeamMessageText said = encode_team_message(message);
+            int n = int(said.chars.size());
+            if(h == 0){ this->__put("(hear %s %.2f self %.*s)", TEAM_NAME, time_match, n, said.chars.data()); }
+            else      { this->__put("(hear %s %.2f %.2f %.*s)", TEAM_NAME, time_match, this->__jitter(0, 180.0f), n, said.chars.data()); }
+        }
+
+        for(int j = 0; j < 2; j++){ this->__put("(HJ (n %s) (ax %.2f))", JOINTS[j], this->__jitter(0, 1.0f)); }
+
+        if(with_vision){
+            this->__buffer += "(See ";
+            this->__buffer += "(G2R "; this->__pol(20.11f, -18.92f, 0.84f); this->__buffer += ") ";
+            this->__buffer += "(G1R "; this->__pol(19.53f, -13.04f, 0.90f); this->__buffer += ") ";
+            this->__buffer += "(F1R "; this->__pol(19.08f,   4.58f, -1.54f); this->__buffer += ") ";
+            this->__buffer += "(F2R "; this->__pol(22.73f, -33.49f, -1.47f); this->__buffer += ") ";
+            this->__buffer += "(B ";   this->__pol(10.12f, -33.09f, -2.94f); this->__buffer += ") ";
+
+            for(int p = 0; p < players; p++){
+                this->__put("(P (team %s) (id %d) ", (p % 2 == 0) ? TEAM_NAME : "Opponent", p + 1);
+                this->__buffer += "(head ";      this->__pol(5.0f + p, 10.0f * p, 2.0f);  this->__buffer += ") ";
+                this->__buffer += "(rlowerarm "; this->__pol(5.0f + p, 10.0f * p, -1.0f); this->__buffer += ") ";
+                this->__buffer += "(llowerarm "; this->__pol(5.0f + p, 10.0f * p, -1.0f); this->__buffer += ") ";
+                this->__buffer += "(rfoot ";     this->__pol(5.0f + p, 10.0f * p, -5.0f); this->__buffer += ") ";
+                this->__buffer += "(lfoot ";     this->__pol(5.0f + p, 10.0f * p, -5.0f); this->__buffer += ")) ";
+            }
+
+            for(int l = 0; l < 15; l++){
+                this->__buffer += "(L ";
+                this->__pol(8.0f + l, -55.0f + 7.0f * l, -2.0f);
+                this->__buffer += " ";
+                this->__pol(9.0f + l, -50.0f + 7.0f * l, -2.5f);
+                this->__buffer += ")";
+                this->__buffer += (l == 14) ? ")" : " ";
+            }
+        }
+
+        for(int j = 2; j < 22; j++){
+            this->__put("(HJ (n %s) (ax %.2f))", JOINTS[j], this->__jitter(0, 1.0f));
+            if(j == 15){ this->__put("(FRP (n rf) (c %.2f %.2f %.2f) (f %.2f %.2f %.2f))", this->__jitter(0, 0.02f), this->__jitter(0, 0.02f), -0.02f, this->__jitter(0, 0.2f), this->__jitter(0, 0.2f), this->__jitter(22.5f, 0.3f)); }
+            if(j == 21){ this->__put("(FRP (n lf) (c %.2f %.2f %.2f) (f %.2f %.2f %.2f))", this->__jitter(0, 0.02f), this->__jitter(0, 0.02f), -0.01f, this->__jitter(0, 0.2f), this->__jitter(0, 0.2f), this->__jitter(22.6f, 0.3f)); }
+        }
+
+        return this->__buffer;
+    }
+};
+
+/**
+ * @class MockServer
+ * @brief Substituto local do rcssserver3d para testes de carga e latência.
+ * @details
+ * Fala o protocolo `[4 bytes de tamanho][S-expression]` na porta configurada, responde aos
+ * comandos `scene` e `init` e, com todos os agentes esperados prontos, passa a emitir percepções:
+ * - Modo síncrono: o próximo ciclo começa assim que todos responderem (syn). Mede a vazão máxima.
+ * - Modo tempo real: um ciclo a cada `cycle_ms` (20 ms no servidor real). Agentes que não
+ *   responderem antes do próximo ciclo contabilizam um "cycle miss".
+ *
+ * Para cada agente registra o tempo entre o envio da percepção e a chegada do seu (syn).
+ */
+class MockServer {
+public:
+    /**
+     * @struct Config
+     * @brief Parâmetros de execução do servidor simulado.
+     */
+    struct Config {
+        int port = AGENT_PORT;      ///< Porta de escuta (3100 no servidor real)
+        int agents = 11;            ///< Agentes esperados antes de iniciar os ciclos
+        int cycles = 500;           ///< Ciclos a simular antes de encerrar
+        int cycle_ms = 20;          ///< Duração do ciclo no modo tempo real
+        bool sync = False;          ///< True: ciclo avança quando todos respondem
+        int players_seen = 2;       ///< Jogadores incluídos em cada bloco 'See'
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    ///< Etapa de cada conexão
+    enum class Stage : uint8_t { CONNECTED, SCENE_DONE, READY, CLOSED };
+
+    /**
+     * @struct Agent
+     * @brief Estado de uma conexão de agente.
+     */
+    struct Agent {
+        int fd = -1;
+        FrameDecoder decoder{16384};
+        std::string pending;                ///< Bytes aceitos por `__send` que o socket ainda não levou
+        size_t pending_at = 0;              ///< Início dos bytes ainda não enviados em `pending`
+        Stage stage = Stage::CONNECTED;
+        int unum = 0;
+        bool answered = True;               ///< Respondeu (syn) à última percepção
+        Clock::time_point sent_at;          ///< Instante do envio da última percepção
+        std::vector<uint32_t> reply_us;     ///< Tempos percepção→(syn), em microssegundos
+        uint64_t misses = 0;                ///< Ciclos sem resposta a tempo
+        uint64_t bytes_in = 0;              ///< Bytes de comandos recebidos
+    };
+
+    Config __cfg;
+    Poller __poller;
+    int __listen_fd = -1;
+    int __timer_fd = -1;
+    std::vector<std::unique_ptr<Agent>> __agents;  ///< Endereço estável: é o dado registrado no epoll
+    PerceptionGenerator __generator;
+    int __cycle = 0;
+    uint64_t __bytes_out = 0;
+    Clock::time_point __first_cycle;
+    Clock::time_point __last_cycle;
+
+    /**
+     * @brief Encerra a conexão de um agente: deixa de monitorá-lo e descarta o que faltava enviar.
+     */
+    void __close(Agent* a) {
+        if(a->stage == Stage::CLOSED){ return; }
+        a->stage = Stage::CLOSED;
+        this->__poller.remove(a->fd);
+        a->pending.clear();
+        a->pending_at = 0;
+    }
+
+    /**
+     * @brief Envia uma mensagem com o cabeçalho de tamanho, sem bloquear.
+     * @details O socket é não-bloqueante: o que o kernel não aceitar de imediato (escrita parcial
+     * ou EAGAIN) fica em `pending`, na ordem, e é enviado por `__flush` quando o epoll sinalizar EPOLLOUT.
+     * Somente os bytes efetivamente aceitos pelo kernel são contados.
+     */
+    void __send(Agent* a, std::string_view body) {
+        if(a->stage == Stage::CLOSED){ return; }
+
+        uint32_t net_len = htonl(static_cast<uint32_t>(body.size()));
+        const char* header = reinterpret_cast<const char*>(&net_len);
+
+        // Já há bytes na fila: este envio vai atrás deles
+        if(a->pending_at < a->pending.size()){
+            a->pending.append(header, 4);
+            a->pending.append(body);
+            return;
+        }
+
+        struct iovec iov[2] = {{&net_len, 4}, {(void*)body.data(), body.size()}};
+        struct msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = 2;
+        ssize_t sent = ::sendmsg(a->fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if(sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR){ this->__close(a); return; }
+
+        size_t done = (sent > 0) ? size_t(sent) : 0;
+        this->__bytes_out += done;
+        if(done == 4 + body.size()){ return; }
+
+        // Escrita parcial: guarda o restante e pede ao epoll para avisar quando houver espaço
+        a->pending.clear();
+        a->pending_at = 0;
+        if(done < 4){ a->pending.append(header + done, 4 - done); }
+        a->pending.append(body.substr(done > 4 ? done - 4 : 0));
+        this->__poller.modify(a->fd, a, EPOLLIN | EPOLLOUT);
+    }
+
+    /**
+     * @brief Envia o que ficou pendente em `__send`; ao esvaziar a fila, volta a monitorar só a leitura.
+     */
+    void __flush(Agent* a) {
+        while(a->pending_at < a->pending.size()){
+            ssize_t sent = ::send(a->fd, a->pending.data() + a->pending_at, a->pending.size() - a->pending_at, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if(sent > 0){ a->pending_at += size_t(sent); this->__bytes_out += size_t(sent); continue; }
+            if(sent < 0 && errno == EINTR){ continue; }
+            if(sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)){ return; } // Continua aguardando EPOLLOUT
+            this->__close(a);
+            return;
+        }
+
+        a->pending.clear();
+        a->pending_at = 0;
+        this->__poller.modify(a->fd, a, EPOLLIN);
+    }
+
+    /**
+     * @brief Quantidade de agentes que concluíram o init.
+     */
+    int __ready() const {
+        return int(std::count_if(this->__agents.begin(), this->__agents.end(), [](const std::unique_ptr<Agent>& a){ return a->stage == Stage::READY; }));
+    }
+
+    /**
+     * @brief Aceita todas as conexões pendentes.
+     */
+    void __accept() {
+        while(True){
+            int fd = ::accept4(this->__listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if(fd < 0){ return; }
+
+            int flag = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+            auto a = std::make_unique<Agent>();
+            a->fd = fd;
+            a->decoder.keep_all(); // Todo comando importa: o anel cresce em vez de descartar
+            a->reply_us.reserve(size_t(this->__cfg.cycles) + 16);
+            this->__poller.add(fd, a.get());
+            this->__agents.push_back(std::move(a));
+        }
+    }
+
+    /**
+     * @brief Lê e interpreta os comandos de um agente.
+     */
+    void __serve(Agent* a) {
+        while(True){
+            ssize_t bytes = a->decoder.fill(a->fd, MSG_DONTWAIT);
+            if(bytes > 0){ a->bytes_in += bytes; continue; }
+            if(bytes < 0 && errno == EINTR){ continue; }
+            if(bytes == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)){ this->__close(a); }
+            break;
+        }
+
+        std::string_view cmd;
+        while(a->decoder.next(cmd)){
+            if(cmd.starts_with("(scene")){
+                a->stage = Stage::SCENE_DONE;
+                this->__send(a, this->__generator.build(0.0f, 0.0f, 0, "BeforeKickOff", False));
+            }
+            else if(cmd.starts_with("(init")){
+                size_t pos = cmd.find("(unum ");
+                a->unum = (pos == std::string_view::npos) ? 0 : std::atoi(cmd.data() + pos + 6);
+                a->stage = Stage::READY;
+                this->__send(a, this->__generator.build(0.0f, 0.0f, a->unum, "BeforeKickOff", False));
+            }
+
+            if(cmd.find("(syn)") != std::string_view::npos && !a->answered){
+                a->answered = True;
+                a->reply_us.push_back(uint32_t(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - a->sent_at).count()));
+            }
+        }
+    }
+
+    /**
+     * @brief Emite a percepção do próximo ciclo para todos os agentes prontos.
+     */
+    void __tick() {
+        if(this->__cycle == 0){ this->__first_cycle = Clock::now(); }
+
+        float time_server = 0.02f * float(this->__cycle);
+        bool with_vision = (this->__cycle % 3) == 0;
+
+        for(const std::unique_ptr<Agent>& a : this->__agents){
+            if(a->stage != Stage::READY){ continue; }
+            if(!a->answered){ a->misses++; }
+
+            a->answered = False;
+            a->sent_at = Clock::now();
+            this->__send(a.get(), this->__generator.build(time_server, time_server, a->unum, "PlayOn", with_vision, this->__cfg.players_seen));
+        }
+
+        this->__cycle++;
+        this->__last_cycle = Clock::now();
+    }
+
+    /**
+     * @brief Verdadeiro se todos os agentes prontos já responderam ao ciclo atual.
+     */
+    bool __all_answered() const {
+        for(const std::unique_ptr<Agent>& a : this->__agents){
+            if(a->stage == Stage::READY && !a->answered){ return False; }
+        }
+        return True;
+    }
+
+public:
+    explicit MockServer(const Config& cfg) : __cfg(cfg) {
+        this->__agents.reserve(32);
+
+        this->__listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int flag = 1;
+        setsockopt(this->__listen_fd, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+
+        struct sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(cfg.port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if(bind(this->__listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(this->__listen_fd, 64) != 0){
+            std::cerr << "Erro fatal: porta " << cfg.port << " indisponivel." << std::endl;
+            exit(1);
+        }
+        this->__poller.add(this->__listen_fd, nullptr);
+
+        // Relógio do modo tempo real
+        this->__timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        this->__poller.add(this->__timer_fd, &this->__timer_fd);
+    }
+
+    ~MockServer() {
+        for(const std::unique_ptr<Agent>& a : this->__agents){ close(a->fd); }
+        close(this->__timer_fd);
+        close(this->__listen_fd);
+    }
+
+    /**
+     * @brief Executa o servidor até completar os ciclos configurados (ou SIGINT).
+     */
+    void
+    run(){
+        bool started = False;
+
+        while(::is_running && this->__cycle < this->__cfg.cycles){
+            int events = this->__poller.wait(100);
+
+            for(int i = 0; i < events; i++){
+                void* data = this->__poller.data(i);
+
+                if(data == nullptr){ this->__accept(); }
+                else if(data == &this->__timer_fd){
+                    uint64_t expirations;
+                    if(read(this->__timer_fd, &expirations, sizeof(expirations)) > 0 && started){ this->__tick(); }
+                }
+                else {
+                    Agent* a = static_cast<Agent*>(data);
+                    if(this->__poller.events(i) & EPOLLOUT){ this->__flush(a); }
+                    if(a->stage != Stage::CLOSED){ this->__serve(a); }
+                }
+            }
+
+            if(!started && this->__ready() >= this->__cfg.agents){
+                started = True;
+                std::printf("[MockServer] %d agentes prontos, iniciando %d ciclos (%s)\n",
+                            this->__ready(), this->__cfg.cycles, this->__cfg.sync ? "sincrono" : "tempo real");
+
+                if(this->__cfg.sync){ this->__tick(); }
+                else {
+                    long ns = long(this->__cfg.cycle_ms) * 1000000L;
+                    struct itimerspec spec = {{ns / 1000000000L, ns % 1000000000L}, {ns / 1000000000L, ns % 1000000000L}};
+                    timerfd_settime(this->__timer_fd, 0, &spec, nullptr);
+                }
+            }
+            else if(started && this->__cfg.sync && this->__all_answered()){ this->__tick(); }
+        }
+    }
+
+    /**
+     * @brief Imprime vazão total, cycle misses e os tempos de resposta por agente.
+     */
+    void
+    print_report(){
+        double seconds = std::chrono::duration<double>(this->__last_cycle - this->__first_cycle).count();
+        uint64_t bytes_in = 0;
+        uint64_t misses = 0;
+        for(const std::unique_ptr<Agent>& a : this->__agents){ bytes_in += a->bytes_in; misses += a->misses; }
+
+        std::printf("\n=== MockServer: %d ciclos em %.3f s (%.1f ciclos/s) ===\n", this->__cycle, seconds, (seconds > 0) ? this->__cycle / seconds : 0.0);
+        std::printf("Bytes enviados: %llu | Bytes recebidos: %llu | Cycle misses: %llu\n",
+                    (unsigned long long)this->__bytes_out, (unsigned long long)bytes_in, (unsigned long long)misses);
+        std::printf("%-6s %8s %8s %10s %10s %10s %10s\n", "unum", "ciclos", "misses", "p50(us)", "p99(us)", "max(us)", "media(us)");
+
+        for(const std::unique_ptr<Agent>& a : this->__agents){
+            std::vector<uint32_t>& v = a->reply_us;
+            if(v.empty()){ std::printf("%-6d %8d %8llu %10s %10s %10s %10s\n", a->unum, 0, (unsigned long long)a->misses, "-", "-", "-", "-"); continue; }
+
+            std::sort(v.begin(), v.end());
+            double mean = 0.0;
+            for(uint32_t x : v){ mean += x; }
+            mean /= double(v.size());
+
+            std::printf("%-6d %8zu %8llu %10u %10u %10u %10.1f\n",
+                        a->unum, v.size(), (unsigned long long)a->misses,
+                        v[v.size() / 2], v[std::min(v.size() - 1, v.size() * 99 / 100)], v.back(), mean);
+        }
+    }
+};
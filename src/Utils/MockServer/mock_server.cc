@@ -0,0 +1,38 @@
+#include "MockServer.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Servidor simulado para testes de carga e latência, sem o rcssserver3d.
+ *
+ * Uso: ./mock_server [--port P] [--agents N] [--cycles M] [--cycle-ms T] [--sync] [--players K]
+ *   --sync      Avança o ciclo assim que todos respondem (vazão máxima).
+ *   --cycle-ms  Duração do ciclo no modo tempo real (padrão: 20 ms, como o servidor real).
+ */
+int main(int argc, char** argv) {
+
+    std::signal(SIGINT, ender);
+
+    MockServer::Config cfg;
+    for(int i = 1; i < argc; i++){
+        bool has_value = (i + 1 < argc);
+
+        if(std::strcmp(argv[i], "--sync") == 0){ cfg.sync = True; }
+        else if(std::strcmp(argv[i], "--port") == 0 && has_value){ cfg.port = std::atoi(argv[++i]); }
+        else if(std::strcmp(argv[i], "--agents") == 0 && has_value){ cfg.agents = std::atoi(argv[++i]); }
+        else if(std::strcmp(argv[i], "--cycles") == 0 && has_value){ cfg.cycles = std::atoi(argv[++i]); }
+        else if(std::strcmp(argv[i], "--cycle-ms") == 0 && has_value){ cfg.cycle_ms = std::atoi(argv[++i]); }
+        else if(std::strcmp(argv[i], "--players") == 0 && has_value){ cfg.players_seen = std::atoi(argv[++i]); }
+        else {
+            std::cerr << "Uso: " << argv[0] << " [--port P] [--agents N] [--cycles M] [--cycle-ms T] [--sync] [--players K]" << std::endl;
+            return 1;
+        }
+    }
+
+    MockServer server(cfg);
+    server.run();
+    server.print_report();
+
+    return 0;
+}
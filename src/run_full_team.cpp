@@ -1,21 +1,60 @@
 #include "Agent/BasePlayer.hpp"
-#include <vector>
+#include "Communication/TeamReactor.hpp"
+#include "Communication/TeamBootstrapper.hpp"
+#include <deque>
+#include <cstdlib>
 
 ///< Verifique o is_left do Environment
 
-int main() {
+/**
+ * Uso: ./a.out [threads]
+ *   threads: se maior que 0, as percepções que chegam juntas são interpretadas em paralelo por um
+ *   ParsePool com essa quantidade de threads auxiliares (TeamReactor::run_batch). Sem argumento,
+ *   cada agente é interpretado assim que seu frame chega (run_once).
+ */
+int main(int argc, char** argv) {
+
+    size_t parse_threads = (argc > 1) ? size_t(std::strtoul(argv[1], nullptr, 10)) : 0;
 
     std::signal(SIGINT, ender);
 
-    std::vector<BasePlayer> players;
-    players.reserve(11);
+#ifdef ENABLE_CAPTURE
+    ///< Grava toda a partida para reprodução offline (ver src/Communication/replay.cc)
+    ///< Capacidade em MB definida por `make capture CAPTURE_MB=...` (padrão: uma partida de 11 agentes)
+#ifdef CAPTURE_MB
+    constexpr size_t CAPTURE_BYTES = size_t(CAPTURE_MB) << 20;
+#else
+    constexpr size_t CAPTURE_BYTES = FrameRecorder::MATCH_CAPACITY;
+#endif
+    FrameRecorder recorder;
+    if(!recorder.open("capture.bin", CAPTURE_BYTES)){
+        std::cout << "Falha ao criar capture.bin" << std::endl;
+        return 1;
+    }
+    ServerComm::record_to(&recorder);
+#endif
+
+    ///< deque: os jogadores nunca são movidos (o ServerComm é dono do socket e é referenciado por endereço)
+    constexpr int AGENTS = 10;
+    BasePlayer::reserve_team(AGENTS);
+    std::deque<BasePlayer> players;
     for(
         int i = 1;
-        i <= 10;
+        i <= AGENTS;
         i++
     ){
-        players.emplace_back(i);
+        players.emplace_back(i, False); // Apenas conecta: o handshake é feito em paralelo abaixo
+    }
+
+    TeamBootstrapper bootstrapper(players.size());
+    for(auto& p : players){
+        bootstrapper.add(&p._scom);
     }
+    if(!bootstrapper.run()){
+        std::cout << "Falha no handshake do time." << std::endl;
+        return 1;
+    }
+    bootstrapper.print_report();
 
     float x = - 0.5;
     for(auto& p : players){
@@ -24,21 +63,35 @@ int main() {
         x -= 1.5;
     }
 
+    ///< A partir daqui, cada agente é conduzido pelo reator assim que sua mensagem chega.
+    TeamReactor reactor(players.size());
     for(auto& p : players){
-        p._scom.receive();
+        reactor.add(&p._scom);
     }
     see_only_when_i_want = true;
 
-    while(::is_running){
-        for(auto& p : players){
-            p._scom.send();
-        }
+    auto think = [&players](size_t i){
+        players[i].perceive();
+        // Espaço reservado para a lógica de decisão do agente players[i]
+    };
+
+    ParsePool pool(parse_threads);
+    while(::is_running && reactor.alive() > 0){
+        if(parse_threads > 0){ reactor.run_batch(100, pool, think); }
+        else { reactor.run_once(100, think); }
+    }
+
+    reactor.print_report();
 
-        for(auto& p : players){
-            p._scom.receive();
-        }
+    CommStats::print_header();
+    for(auto& p : players){
+        p._scom.stats().print_row(p._env.unum);
     }
 
+#ifdef ENABLE_CAPTURE
+    std::cout << "Captura: " << recorder.frames() << " frames gravados, " << recorder.dropped() << " descartados." << std::endl;
+#endif
+
     std::cout << "Encerrando corretamente." << std::flush;
 
     return 0;
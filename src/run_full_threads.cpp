@@ -1,50 +1,78 @@
 #include "Agent/BasePlayer.hpp"
+#include "Agent/TeamScheduler.hpp"
+#include "Communication/TeamBootstrapper.hpp"
 #include <thread>
 #include <vector>
+#include <deque>
+#include <cstdlib>
 
-void worker(BasePlayer* p, int* valor_a_ser_incrementado) {
+/**
+ * Uso: ./a.out [nucleos]
+ *   nucleos: lista separada por vírgulas (ex: "0,2,4,6") em que as threads dos agentes serão fixadas.
+ *   Sem argumento, o agente i é fixado no núcleo i % std::thread::hardware_concurrency().
+ */
+int main(int argc, char** argv) {
 
-    std::cout << "Estou aqui vendo: " << static_cast<void*>(p) << std::endl;
-    while(
-        *valor_a_ser_incrementado < 15
-    ){
-        std::cout << "Neste momento, vejo: " << *valor_a_ser_incrementado << std::endl;
-        (*valor_a_ser_incrementado)++;
-        usleep(1*1000*1000);
-    }
-    std::cout << "Saindo." << std::endl;
-}
+    std::signal(SIGINT, ender);
 
-int main() {
+    std::vector<int> cores;
+    if(argc > 1){
+        for(char* p = argv[1]; *p != '\0'; ){
+            cores.push_back(std::strtol(p, &p, 10));
+            if(*p == ','){ p++; }
+            else if(*p != '\0'){ std::cerr << "Lista de nucleos invalida: " << argv[1] << std::endl; return 1; }
+        }
+    }
+    else {
+        for(unsigned c = 0; c < std::max(1u, std::thread::hardware_concurrency()); c++){ cores.push_back(int(c)); }
+    }
 
-    ///< Por motivos de cuidado, faremos inicialização de forma sequencial
-    std::vector<BasePlayer> players;
-    players.reserve(11);
+    ///< deque: os jogadores nunca são movidos (o ServerComm é dono do socket e é referenciado por endereço)
+    constexpr int AGENTS = 11;
+    BasePlayer::reserve_team(AGENTS);
+    std::deque<BasePlayer> players;
     for(
         int i = 1;
-        i <= 11;
+        i <= AGENTS;
         i++
     ){
-        players.emplace_back(i);
+        players.emplace_back(i, False); // Apenas conecta: o handshake é feito em paralelo abaixo
+    }
+
+    TeamBootstrapper bootstrapper(players.size());
+    for(auto& p : players){
+        bootstrapper.add(&p._scom);
+    }
+    if(!bootstrapper.run()){
+        std::cout << "Falha no handshake do time." << std::endl;
+        return 1;
     }
+    bootstrapper.print_report();
 
-    std::vector<std::thread> threads;
-    threads.reserve(11);
-    int valores[11] = {0};
-    int i = 0;
-
-    for(auto& p : players) {  // Captura referência se players for container
-        threads.emplace_back(
-            [&p, &valores, i]() {  // &valores captura referência ao array
-                worker(&p, valores + i);
-            }
-        );
-        i++;
+    for(auto& p : players){
+        p.commit_beam(0, 0, 0, True);
+        p._scom.send();
     }
 
-    for(auto& t: threads){
-        if(t.joinable()){ t.join(); }
+    ///< A partir daqui, cada agente é conduzido por sua própria thread
+    TeamScheduler scheduler(cores);
+    scheduler.run(
+        players,
+        [](size_t i, BasePlayer& p){
+            p.perceive();
+            // Espaço reservado para a lógica de decisão do agente (executa na thread do agente i)
+            (void)i;
+        }
+    );
+
+    scheduler.print_report();
+
+    CommStats::print_header();
+    for(auto& p : players){
+        p._scom.stats().print_row(p._env.unum);
     }
 
+    std::cout << "Encerrando corretamente." << std::endl;
+
     return 0;
-}
\ No newline at end of file
+}
@@ -7,6 +7,7 @@ int main() {
     while(True){
         p._scom.send();
         p._scom.receive();
+        p.perceive();
     }
 
     return 0;